@@ -0,0 +1,770 @@
+//This file contains a headless benchmark that drives every segue effect
+//through its full duration and reports what each one costs per frame.
+//
+//No window is shown. SFML still needs a GL context so on machines without
+//a GPU or display run it under a software rasterizer, e.g.
+//
+//    xvfb-run -a env LIBGL_ALWAYS_SOFTWARE=1 GALLIUM_DRIVER=llvmpipe ./swoosh_segue_bench --format csv
+//
+//Options:
+//    --format csv|json   output format (default csv)
+//    --out <file>        write the report to a file instead of stdout
+//    --frames            also report every frame, not just the summary of each run
+//    --golden <dir>      compare frames against the PNGs in <dir> instead of benchmarking.
+//                        Exits with 2 if any frame changed or has no PNG, including when <dir> is empty.
+//    --update-golden     write the frames at t = 0, 0.25, 0.5, 0.75, 1 into the --golden directory instead of comparing
+//    --tolerance <0-1>   perceptual color distance a pixel may move before it counts as changed (default 0.1)
+//    --max-diff <pct>    percent of changed pixels a frame may have (default 0.1)
+//
+//Golden frames are rendered at 320x180 in every quality mode, and once more with shaders disabled so the
+//CPU fallbacks are covered too. Each segue gets a fresh controller, so a frame only depends on the segue
+//that drew it. Each PNG is named after the frame it holds, and the last one marks the frame the effect
+//must end on. Render them with the same rasterizer you compare with. CTest runs this as segue_golden
+//against Benchmark/golden.
+
+#include <SFML/Graphics.hpp>
+#include <Swoosh/ActivityController.h>
+
+using namespace swoosh;
+using namespace swoosh::types;
+
+#include <Segues/BlackWashFade.h>
+#include <Segues/BlendFadeIn.h>
+#include <Segues/BlurFadeIn.h>
+#include <Segues/Checkerboard.h>
+#include <Segues/CircleClose.h>
+#include <Segues/CircleOpen.h>
+#include <Segues/CrossZoom.h>
+#include <Segues/Cube3D.h>
+#include <Segues/DiamondTileCircle.h>
+#include <Segues/DiamondTileSwipe.h>
+#include <Segues/Dream.h>
+#include <Segues/HorizontalOpen.h>
+#include <Segues/HorizontalSlice.h>
+#include <Segues/Morph.h>
+#include <Segues/PageTurn.h>
+#include <Segues/PixelateBlackWashFade.h>
+#include <Segues/PushIn.h>
+#include <Segues/RadialCCW.h>
+#include <Segues/RetroBlit.h>
+#include <Segues/SlideIn.h>
+#include <Segues/SwipeIn.h>
+#include <Segues/VerticalOpen.h>
+#include <Segues/VerticalSlice.h>
+#include <Segues/WhiteWashFade.h>
+#include <Segues/ZoomFadeIn.h>
+#include <Segues/ZoomFadeInBounce.h>
+#include <Segues/ZoomIn.h>
+#include <Segues/ZoomOut.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+/*
+Every heap allocation in the process is counted so we can see which effects allocate per frame
+*/
+static std::atomic<std::size_t> heapAllocations{ 0 };
+
+void* operator new(std::size_t size) {
+  heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+/*
+Every draw SFML makes ends in glDrawArrays. On Linux the bench defines it so calls from SFML land here first,
+then forwards them to the driver's. Elsewhere draw calls are reported as 0.
+*/
+static std::atomic<std::size_t> drawCalls{ 0 };
+
+#if defined(__linux__)
+#include <dlfcn.h>
+
+extern "C" void glDrawArrays(unsigned int mode, int first, int count) {
+  using DrawArrays = void(*)(unsigned int, int, int);
+  static DrawArrays driver = reinterpret_cast<DrawArrays>(dlsym(RTLD_NEXT, "glDrawArrays"));
+
+  drawCalls.fetch_add(1, std::memory_order_relaxed);
+  driver(mode, first, count);
+}
+#endif
+
+/*
+A procedural scene so the benchmark needs no resources on disk.
+It animates every frame, like a real game scene, so segues cannot skip redrawing it.
+*/
+class BenchScene : public Activity {
+private:
+  sf::RectangleShape cell;
+  sf::CircleShape ball;
+  float angle{};
+
+public:
+  BenchScene(ActivityController& controller, sf::Color color) : Activity(&controller) {
+    setBGColor(color);
+    cell.setFillColor(sf::Color(255, 255, 255, 96));
+    ball.setFillColor(sf::Color::Yellow);
+  }
+
+  void onStart() override { }
+  void onLeave() override { }
+  void onExit() override { }
+  void onEnter() override { }
+  void onResume() override { }
+  void onEnd() override { }
+
+  void onUpdate(double elapsed) override {
+    angle += static_cast<float>(elapsed) * 90.0f;
+  }
+
+  void onDraw(sf::RenderTexture& surface) override {
+    sf::Vector2u size = getController().getVirtualWindowSize();
+    float w = size.x / 16.0f;
+    float h = size.y / 9.0f;
+
+    cell.setSize(sf::Vector2f(w - 2.0f, h - 2.0f));
+
+    for (int y = 0; y < 9; y++) {
+      for (int x = (y % 2); x < 16; x += 2) {
+        cell.setPosition(x * w, y * h);
+        surface.draw(cell);
+      }
+    }
+
+    ball.setRadius(h);
+    ball.setOrigin(h, h);
+    ball.setPosition(size.x * 0.5f, size.y * 0.5f);
+    ball.setRotation(angle);
+    surface.draw(ball);
+  }
+};
+
+/*
+One effect to benchmark. `start` replaces the top scene with the effect.
+*/
+struct BenchCase {
+  std::string name;
+  std::function<void(ActivityController&, sf::Color)> start;
+};
+
+template<typename Effect>
+BenchCase makeCase(const std::string& name) {
+  return BenchCase{ name, [](ActivityController& app, sf::Color color) {
+    app.replace<typename segue<Effect, sec<1>>::template to<BenchScene>>(color);
+  } };
+}
+
+struct FrameSample {
+  double cpuMs{};
+  std::size_t heapAllocations{};
+  std::size_t surfaceAllocations{};
+  std::size_t bytesCopied{};
+  std::size_t drawCalls{};
+  std::size_t textureCopies{}; //!< Activities captured into a surface this frame
+};
+
+struct RunResult {
+  std::string segue;
+  sf::Vector2u size;
+  std::string quality;
+  std::vector<FrameSample> frames;
+};
+
+static const char* qualityName(quality mode) {
+  switch (mode) {
+  case quality::realtime: return "realtime";
+  case quality::reduced:  return "reduced";
+  case quality::mobile:   return "mobile";
+  }
+
+  return "unknown";
+}
+
+static const Segue* currentSegue(const ActivityController& app) {
+  return dynamic_cast<const Segue*>(app.getCurrentActivity());
+}
+
+/*
+Called with the index and contents of every frame a run draws. Not counted in the frame's cost.
+*/
+using FrameInspector = std::function<void(std::size_t frame, const sf::RenderTexture& target)>;
+
+/*
+Drives one effect from its first to its last frame at 60 fps.
+CPU time covers update() and draw() but not the GPU catching up.
+Bytes copied counts full surface writes: every activity capture plus the draw into the target.
+*/
+static RunResult run(ActivityController& app, sf::RenderTexture& target, const BenchCase& bench, quality mode, const FrameInspector& inspect = nullptr) {
+  RunResult result;
+  result.segue = bench.name;
+  result.size = app.getVirtualWindowSize();
+  result.quality = qualityName(mode);
+
+  const double dt = 1.0 / 60.0;
+  const std::size_t surfaceBytes = static_cast<std::size_t>(result.size.x) * result.size.y * 4u;
+
+  app.optimizeForPerformance(mode);
+  bench.start(app, sf::Color(20, 60, 140));
+
+  std::size_t captures = 0;
+
+  while (const Segue* segue = currentSegue(app)) {
+    FrameSample sample;
+
+    // The controller draws over whatever the target holds
+    target.clear(sf::Color::Black);
+
+    std::size_t allocsBefore = heapAllocations.load(std::memory_order_relaxed);
+    std::size_t missesBefore = app.getSurfacePoolStats().misses;
+    std::size_t drawsBefore = drawCalls.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+
+    app.update(dt);
+
+    // The update may have ended the effect
+    if ((segue = currentSegue(app))) {
+      app.draw(target);
+      target.display();
+      sample.textureCopies = segue->getCaptureCount() - captures;
+      sample.bytesCopied = (sample.textureCopies + 1) * surfaceBytes;
+      captures = segue->getCaptureCount();
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    sample.cpuMs = elapsed.count();
+    sample.heapAllocations = heapAllocations.load(std::memory_order_relaxed) - allocsBefore;
+    sample.surfaceAllocations = app.getSurfacePoolStats().misses - missesBefore;
+    sample.drawCalls = drawCalls.load(std::memory_order_relaxed) - drawsBefore;
+
+    if (segue) {
+      if (inspect) {
+        inspect(result.frames.size(), target);
+      }
+
+      result.frames.push_back(sample);
+    }
+  }
+
+  return result;
+}
+
+static double percentile(std::vector<double> values, double p) {
+  if (values.empty()) return 0.0;
+
+  std::sort(values.begin(), values.end());
+  return values[static_cast<std::size_t>(p * (values.size() - 1) + 0.5)];
+}
+
+struct Summary {
+  double meanMs{}, p95Ms{}, maxMs{};
+  double heapAllocationsPerFrame{};
+  std::size_t surfaceAllocations{};
+  double bytesCopiedPerFrame{};
+  double drawCallsPerFrame{};
+  double textureCopiesPerFrame{};
+};
+
+static Summary summarize(const RunResult& result) {
+  Summary summary;
+  std::vector<double> times;
+
+  for (auto& frame : result.frames) {
+    times.push_back(frame.cpuMs);
+    summary.meanMs += frame.cpuMs;
+    summary.heapAllocationsPerFrame += static_cast<double>(frame.heapAllocations);
+    summary.surfaceAllocations += frame.surfaceAllocations;
+    summary.bytesCopiedPerFrame += static_cast<double>(frame.bytesCopied);
+    summary.drawCallsPerFrame += static_cast<double>(frame.drawCalls);
+    summary.textureCopiesPerFrame += static_cast<double>(frame.textureCopies);
+  }
+
+  if (!times.empty()) {
+    double n = static_cast<double>(times.size());
+    summary.meanMs /= n;
+    summary.heapAllocationsPerFrame /= n;
+    summary.bytesCopiedPerFrame /= n;
+    summary.drawCallsPerFrame /= n;
+    summary.textureCopiesPerFrame /= n;
+    summary.p95Ms = percentile(times, 0.95);
+    summary.maxMs = *std::max_element(times.begin(), times.end());
+  }
+
+  return summary;
+}
+
+static void writeCSV(std::ostream& out, const std::vector<RunResult>& results, bool perFrame) {
+  out << "segue,width,height,quality,frames,cpu_ms_mean,cpu_ms_p95,cpu_ms_max,"
+         "heap_allocs_per_frame,surface_allocs,bytes_copied_per_frame,draw_calls_per_frame,texture_copies_per_frame\n";
+
+  for (auto& result : results) {
+    Summary s = summarize(result);
+    out << result.segue << "," << result.size.x << "," << result.size.y << "," << result.quality << ","
+        << result.frames.size() << "," << s.meanMs << "," << s.p95Ms << "," << s.maxMs << ","
+        << s.heapAllocationsPerFrame << "," << s.surfaceAllocations << "," << s.bytesCopiedPerFrame << ","
+        << s.drawCallsPerFrame << "," << s.textureCopiesPerFrame << "\n";
+  }
+
+  if (!perFrame) return;
+
+  out << "\nsegue,width,height,quality,frame,cpu_ms,heap_allocs,surface_allocs,bytes_copied,draw_calls,texture_copies\n";
+
+  for (auto& result : results) {
+    for (std::size_t i = 0; i < result.frames.size(); i++) {
+      const FrameSample& f = result.frames[i];
+      out << result.segue << "," << result.size.x << "," << result.size.y << "," << result.quality << ","
+          << i << "," << f.cpuMs << "," << f.heapAllocations << "," << f.surfaceAllocations << "," << f.bytesCopied << ","
+          << f.drawCalls << "," << f.textureCopies << "\n";
+    }
+  }
+}
+
+static void writeJSON(std::ostream& out, const std::vector<RunResult>& results, bool perFrame) {
+  out << "[\n";
+
+  for (std::size_t r = 0; r < results.size(); r++) {
+    const RunResult& result = results[r];
+    Summary s = summarize(result);
+
+    out << "  {\"segue\": \"" << result.segue << "\", \"width\": " << result.size.x << ", \"height\": " << result.size.y
+        << ", \"quality\": \"" << result.quality << "\", \"frames\": " << result.frames.size()
+        << ", \"cpu_ms_mean\": " << s.meanMs << ", \"cpu_ms_p95\": " << s.p95Ms << ", \"cpu_ms_max\": " << s.maxMs
+        << ", \"heap_allocs_per_frame\": " << s.heapAllocationsPerFrame << ", \"surface_allocs\": " << s.surfaceAllocations
+        << ", \"bytes_copied_per_frame\": " << s.bytesCopiedPerFrame << ", \"draw_calls_per_frame\": " << s.drawCallsPerFrame
+        << ", \"texture_copies_per_frame\": " << s.textureCopiesPerFrame;
+
+    if (perFrame) {
+      out << ", \"per_frame\": [";
+
+      for (std::size_t i = 0; i < result.frames.size(); i++) {
+        const FrameSample& f = result.frames[i];
+        out << (i ? ", " : "") << "{\"cpu_ms\": " << f.cpuMs << ", \"heap_allocs\": " << f.heapAllocations
+            << ", \"surface_allocs\": " << f.surfaceAllocations << ", \"bytes_copied\": " << f.bytesCopied
+            << ", \"draw_calls\": " << f.drawCalls << ", \"texture_copies\": " << f.textureCopies << "}";
+      }
+
+      out << "]";
+    }
+
+    out << "}" << (r + 1 < results.size() ? "," : "") << "\n";
+  }
+
+  out << "]\n";
+}
+
+/*
+Golden frames are written at these points of an effect. 0 is its first frame and 1 its last.
+*/
+static const double goldenTimes[] = { 0.0, 0.25, 0.5, 0.75, 1.0 };
+
+static std::size_t goldenFrame(double t, std::size_t frameCount) {
+  return static_cast<std::size_t>(std::lround(t * (frameCount - 1)));
+}
+
+/*
+One way of rendering every case for the golden frames
+*/
+struct GoldenPass {
+  quality mode;
+  bool shaders;
+};
+
+static const GoldenPass goldenPasses[] = {
+  { quality::realtime, true },
+  { quality::reduced, true },
+  { quality::mobile, true },
+  { quality::realtime, false } // the CPU fallbacks do not change with the quality mode
+};
+
+// e.g. "Cube3D<left>" in realtime becomes "Cube3D-left-realtime-" and its 15th frame "Cube3D-left-realtime-f014.png".
+// "Dream" without shaders becomes "Dream-realtime-cpu-"
+static std::string goldenPrefix(const std::string& segue, const GoldenPass& pass) {
+  std::string name;
+
+  for (char c : segue) {
+    if (c == '<' || c == ',') name += '-';
+    else if (c != '>') name += c;
+  }
+
+  return name + "-" + qualityName(pass.mode) + (pass.shaders ? "-" : "-cpu-");
+}
+
+static std::string goldenFile(const std::string& dir, const std::string& prefix, std::size_t frame) {
+  char stamp[16];
+  std::snprintf(stamp, sizeof(stamp), "f%03zu", frame);
+
+  return dir + "/" + prefix + stamp + ".png";
+}
+
+/*
+Finds the golden frames of one segue in one pass by their names. Returns frame number to path, in order.
+*/
+static std::map<std::size_t, std::string> goldenFrames(const std::string& dir, const std::string& prefix) {
+  std::map<std::size_t, std::string> frames;
+  std::error_code error;
+
+  for (const auto& entry : std::filesystem::directory_iterator(dir, error)) {
+    const std::string name = entry.path().filename().string();
+
+    // prefix, 'f', digits, ".png". Rejects other passes and .actual.png files
+    if (name.size() < prefix.size() + 6 || name.compare(0, prefix.size(), prefix) != 0) continue;
+
+    const std::string stamp = name.substr(prefix.size());
+
+    if (stamp[0] != 'f' || stamp.compare(stamp.size() - 4, 4, ".png") != 0) continue;
+
+    const std::string digits = stamp.substr(1, stamp.size() - 5);
+
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) continue;
+
+    frames.emplace(static_cast<std::size_t>(std::stoul(digits)), entry.path().string());
+  }
+
+  return frames;
+}
+
+static bool hasGoldenFrames(const std::string& dir) {
+  std::error_code error;
+
+  for (const auto& entry : std::filesystem::directory_iterator(dir, error)) {
+    if (entry.path().extension() == ".png") return true;
+  }
+
+  return false;
+}
+
+/*
+Perceptual distance between two pixels in [0, 1], after Kotsarenko and Ramos' YIQ metric.
+Brightness weighs more than hue so antialiasing and rounding noise stay under the tolerance while real changes do not.
+Pixels are blended over white first so transparent pixels compare by what they would look like.
+*/
+static double colorDelta(const sf::Uint8* a, const sf::Uint8* b) {
+  auto yiq = [](const sf::Uint8* p, double out[3]) {
+    double alpha = p[3] / 255.0;
+    double r = 255.0 + (p[0] - 255.0) * alpha;
+    double g = 255.0 + (p[1] - 255.0) * alpha;
+    double bl = 255.0 + (p[2] - 255.0) * alpha;
+
+    out[0] = r * 0.29889531 + g * 0.58662247 + bl * 0.11448223;
+    out[1] = r * 0.59597799 - g * 0.27417610 - bl * 0.32180189;
+    out[2] = r * 0.21147017 - g * 0.52261711 + bl * 0.31114694;
+  };
+
+  double p[3], q[3];
+  yiq(a, p);
+  yiq(b, q);
+
+  double y = p[0] - q[0], i = p[1] - q[1], j = p[2] - q[2];
+
+  // 35215 is the squared distance between black and white
+  return std::sqrt((0.5053 * y * y + 0.299 * i * i + 0.1957 * j * j) / 35215.0);
+}
+
+/*
+Fraction of pixels further apart than `tolerance`. Images of different sizes differ everywhere.
+*/
+static double changedPixels(const sf::Image& actual, const sf::Image& expected, double tolerance) {
+  if (actual.getSize() != expected.getSize()) return 1.0;
+
+  const sf::Uint8* a = actual.getPixelsPtr();
+  const sf::Uint8* b = expected.getPixelsPtr();
+  const std::size_t count = static_cast<std::size_t>(actual.getSize().x) * actual.getSize().y;
+
+  if (count == 0) return 0.0;
+
+  std::size_t changed = 0;
+
+  for (std::size_t i = 0; i < count; i++) {
+    if (colorDelta(a + i * 4, b + i * 4) > tolerance) {
+      changed++;
+    }
+  }
+
+  return static_cast<double>(changed) / count;
+}
+
+/*
+Renders every case in every golden pass and compares the frames named by the images in `dir` with them.
+The highest numbered image of a case is its last frame, so an effect that ends early or late fails too.
+A case with no images fails. With `update` the frames at goldenTimes are written instead, replacing any
+images of that case. Frames that do not match are written next to the golden image as <name>.actual.png
+so the two can be compared by eye.
+
+The report lists the cost of each checked frame next to the result so a change in output can be read
+together with a change in draw calls, texture copies, or CPU time. Returns the number of frames that did not match.
+*/
+static std::size_t checkGolden(std::ostream& out, sf::RenderWindow& window, const std::vector<BenchCase>& cases,
+                               const std::string& dir, bool update, double tolerance, double maxChanged) {
+  const sf::Vector2u size(320, 180);
+  std::size_t failures = 0;
+
+  out << "segue,quality,shaders,t,frame,result,changed_pct,cpu_ms,draw_calls,texture_copies\n";
+
+  for (const GoldenPass& pass : goldenPasses) {
+    const quality mode = pass.mode;
+
+    for (const BenchCase& bench : cases) {
+      // A fresh controller and scene so the frames do not depend on what ran before
+      ActivityController app(window, size);
+      app.enableShaders(pass.shaders);
+      sf::RenderTexture target;
+
+      if (!target.create(size.x, size.y)) {
+        std::cerr << "could not create a " << size.x << "x" << size.y << " render target" << std::endl;
+        return ++failures;
+      }
+
+      app.push<BenchScene>(sf::Color(140, 40, 60));
+      app.update(0.0); // start the first scene
+
+      const std::string prefix = goldenPrefix(bench.name, pass);
+      const std::map<std::size_t, std::string> golden = goldenFrames(dir, prefix);
+      std::map<std::size_t, sf::Image> frames;
+
+      RunResult result = run(app, target, bench, mode, [&](std::size_t frame, const sf::RenderTexture& drawn) {
+        // The frame count is only known at the end, so every frame is kept when updating
+        if (update || golden.count(frame)) {
+          frames[frame] = drawn.getTexture().copyToImage();
+        }
+      });
+
+      const std::size_t frameCount = result.frames.size();
+
+      auto report = [&](std::size_t frame, std::size_t lastFrame, const std::string& verdict, double changed) {
+        FrameSample cost = frame < frameCount ? result.frames[frame] : FrameSample();
+        double t = lastFrame ? static_cast<double>(frame) / lastFrame : 0.0;
+
+        out << bench.name << "," << qualityName(mode) << "," << (pass.shaders ? "on" : "off") << "," << t << "," << frame << "," << verdict << ","
+            << changed * 100.0 << "," << cost.cpuMs << "," << cost.drawCalls << "," << cost.textureCopies << "\n";
+      };
+
+      if (update) {
+        // Images of an older frame count would otherwise be compared too
+        for (const auto& [frame, path] : golden) {
+          std::error_code error;
+          std::filesystem::remove(path, error);
+        }
+
+        if (frameCount == 0) {
+          report(0, 0, "no_frames", 0.0);
+          failures++;
+        }
+
+        for (std::size_t i = 0; frameCount && i < std::size(goldenTimes); i++) {
+          const std::size_t frame = goldenFrame(goldenTimes[i], frameCount);
+          const bool written = frames[frame].saveToFile(goldenFile(dir, prefix, frame));
+
+          report(frame, frameCount - 1, written ? "written" : "write_failed", 0.0);
+          failures += written ? 0 : 1;
+        }
+      }
+      else if (golden.empty()) {
+        report(0, 0, "missing", 0.0);
+        failures++;
+      }
+      else {
+        const std::size_t lastFrame = golden.rbegin()->first;
+
+        for (const auto& [frame, path] : golden) {
+          std::string verdict = "match";
+          double changed = 0.0;
+          sf::Image expected;
+
+          if (frameCount != lastFrame + 1) {
+            verdict = "frame_count_" + std::to_string(frameCount);
+            failures++;
+          }
+          else if (!expected.loadFromFile(path)) {
+            verdict = "unreadable";
+            failures++;
+          }
+          else if ((changed = changedPixels(frames[frame], expected, tolerance)) > maxChanged) {
+            verdict = "changed";
+            failures++;
+            frames[frame].saveToFile(path.substr(0, path.size() - 4) + ".actual.png");
+          }
+
+          report(frame, lastFrame, verdict, changed);
+        }
+      }
+
+      std::cerr << bench.name << " " << qualityName(mode) << (pass.shaders ? "" : " without shaders") << " checked" << std::endl;
+    }
+  }
+
+  return failures;
+}
+
+int main(int argc, char** argv) {
+  std::string format = "csv";
+  std::string outPath;
+  bool perFrame = false;
+  std::string goldenDir;
+  bool updateGolden = false;
+  double tolerance = 0.1;
+  double maxChangedPct = 0.1;
+
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+      format = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+      outPath = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--frames") == 0) {
+      perFrame = true;
+    }
+    else if (std::strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+      goldenDir = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--update-golden") == 0) {
+      updateGolden = true;
+    }
+    else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+      tolerance = std::atof(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--max-diff") == 0 && i + 1 < argc) {
+      maxChangedPct = std::atof(argv[++i]);
+    }
+    else {
+      std::cerr << "usage: " << argv[0] << " [--format csv|json] [--out file] [--frames]"
+                << " [--golden dir [--update-golden] [--tolerance 0-1] [--max-diff pct]]" << std::endl;
+      return 1;
+    }
+  }
+
+  if (updateGolden && goldenDir.empty()) {
+    std::cerr << "--update-golden needs --golden <dir>" << std::endl;
+    return 1;
+  }
+
+  if (updateGolden) {
+    std::error_code error;
+    std::filesystem::create_directories(goldenDir, error);
+  }
+  else if (!goldenDir.empty() && !hasGoldenFrames(goldenDir)) {
+    // Nothing to compare is a failure, not a pass
+    std::cerr << "no golden frames in " << goldenDir << ". Write them with --update-golden" << std::endl;
+    return 2;
+  }
+
+  const std::vector<BenchCase> cases = {
+    makeCase<BlackWashFade>("BlackWashFade"),
+    makeCase<BlendFadeIn>("BlendFadeIn"),
+    makeCase<BlurFadeIn>("BlurFadeIn"),
+    makeCase<Checkerboard>("Checkerboard"),
+    makeCase<CheckerboardCustom<4, 3>>("CheckerboardCustom<4,3>"),
+    makeCase<CircleClose>("CircleClose"),
+    makeCase<CircleOpen>("CircleOpen"),
+    makeCase<CrossZoom>("CrossZoom"),
+    makeCase<Cube3D<direction::left>>("Cube3D<left>"),
+    makeCase<Cube3D<direction::up>>("Cube3D<up>"),
+    makeCase<DiamondTileCircle>("DiamondTileCircle"),
+    makeCase<DiamondTileSwipe<direction::right>>("DiamondTileSwipe<right>"),
+    makeCase<Dream>("Dream"),
+    makeCase<DreamCustom<30>>("DreamCustom<30>"),
+    makeCase<HorizontalOpen>("HorizontalOpen"),
+    makeCase<HorizontalSlice>("HorizontalSlice"),
+    makeCase<Morph>("Morph"),
+    makeCase<PageTurn>("PageTurn"),
+    makeCase<PixelateBlackWashFade>("PixelateBlackWashFade"),
+    makeCase<PushIn<direction::left>>("PushIn<left>"),
+    makeCase<RadialCCW>("RadialCCW"),
+    makeCase<RetroBlit>("RetroBlit"),
+    makeCase<SlideIn<direction::left>>("SlideIn<left>"),
+    makeCase<SwipeIn<direction::left>>("SwipeIn<left>"),
+    makeCase<VerticalOpen>("VerticalOpen"),
+    makeCase<VerticalSlice>("VerticalSlice"),
+    makeCase<WhiteWashFade>("WhiteWashFade"),
+    makeCase<ZoomFadeIn>("ZoomFadeIn"),
+    makeCase<ZoomFadeInBounce>("ZoomFadeInBounce"),
+    makeCase<ZoomIn>("ZoomIn"),
+    makeCase<ZoomOut>("ZoomOut")
+  };
+
+  const std::vector<sf::Vector2u> resolutions = {
+    sf::Vector2u(640, 360), sf::Vector2u(1280, 720), sf::Vector2u(1920, 1080)
+  };
+
+  const quality modes[] = { quality::realtime, quality::reduced, quality::mobile };
+
+  std::ofstream file;
+  std::ostream* out = &std::cout;
+
+  if (!outPath.empty()) {
+    file.open(outPath);
+
+    if (!file) {
+      std::cerr << "could not open " << outPath << std::endl;
+      return 1;
+    }
+
+    out = &file;
+  }
+
+  // The controller needs a window but nothing is ever shown on it
+  sf::RenderWindow window(sf::VideoMode(64, 64), "Swoosh Segue Bench", sf::Style::None);
+  window.setVisible(false);
+
+  if (!goldenDir.empty()) {
+    std::size_t failures = checkGolden(*out, window, cases, goldenDir, updateGolden, tolerance, maxChangedPct / 100.0);
+
+    if (failures) {
+      std::cerr << failures << " golden frame(s) did not match" << std::endl;
+      return 2;
+    }
+
+    return 0;
+  }
+
+  std::vector<RunResult> results;
+
+  for (const sf::Vector2u& size : resolutions) {
+    ActivityController app(window, size);
+    sf::RenderTexture target;
+
+    if (!target.create(size.x, size.y)) {
+      std::cerr << "could not create a " << size.x << "x" << size.y << " render target" << std::endl;
+      return 1;
+    }
+
+    app.push<BenchScene>(sf::Color(140, 40, 60));
+    app.update(0.0); // start the first scene
+
+    for (quality mode : modes) {
+      for (const BenchCase& bench : cases) {
+        results.push_back(run(app, target, bench, mode));
+        std::cerr << bench.name << " " << size.x << "x" << size.y << " " << qualityName(mode) << " done" << std::endl;
+      }
+    }
+  }
+
+  if (format == "json") {
+    writeJSON(*out, results, perFrame);
+  }
+  else {
+    writeCSV(*out, results, perFrame);
+  }
+
+  return 0;
+}
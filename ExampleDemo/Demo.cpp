@@ -27,6 +27,10 @@ int main()
   app.optimizeForPerformance(quality::realtime); 
   // app.optimizeForPerformance(quality::mobile); // <-- uncomment me!
 
+  // Compile the shaders of the segues used in this demo up front
+  // so that the first time each transition plays it does not hitch
+  app.precompile<DreamCustom<50>, BlurFadeIn, CheckerboardCustom<40, 40>, CircleClose, Cube3D<direction::right>>();
+
   // (DEFAULT BEHAVIOR!)
   // Add the Main Menu Scene as the first and only scene in our stack
   // This is our starting point for the user
@@ -38,7 +42,7 @@ int main()
   // the screen transition as demonstrated here
   app.push<segue<ZoomOut>::to<MainMenuScene>>();
 
-  sf::Texture* cursorTexture = loadTexture(CURSOR_PATH);
+  std::shared_ptr<sf::Texture> cursorTexture = app.getResources().loadTexture(CURSOR_PATH);
   sf::Sprite cursor;
 
   cursor.setTexture(*cursorTexture);
@@ -92,7 +96,5 @@ int main()
     elapsed = static_cast<float>(clock.getElapsedTime().asSeconds());
   }
 
-  delete cursorTexture;
-
   return 0;
 }
@@ -1,6 +1,5 @@
 #pragma once
 
-#include "../TextureLoader.h"
 #include "../Particle.h"
 #include "../Button.h"
 #include "../ResourcePaths.h"
@@ -32,17 +31,17 @@ using namespace swoosh::types;
 
 class AboutScene : public Activity {
 private:
-  sf::Texture * btn;
-  sf::Texture * sfmlTexture;
+  std::shared_ptr<sf::Texture> btn;
+  std::shared_ptr<sf::Texture> sfmlTexture;
   sf::Sprite sfml;
   button goback;
 
-  sf::Font manual;
-  sf::Font font;
+  std::shared_ptr<sf::Font> manual;
+  std::shared_ptr<sf::Font> font;
   sf::Text text;
   std::string info;
 
-  sf::SoundBuffer buffer;
+  std::shared_ptr<sf::SoundBuffer> buffer;
   sf::Sound selectFX;
 
   float screenDiv;
@@ -57,18 +56,18 @@ public:
   AboutScene(ActivityController& controller) : Activity(&controller) {
     canClick = false;
 
-    font.loadFromFile(GAME_FONT);
-    text.setFont(font);
+    font = getController().getResources().loadFont(GAME_FONT);
+    text.setFont(*font);
     text.setFillColor(sf::Color::White);
 
-    manual.loadFromFile(MANUAL_FONT);
+    manual = getController().getResources().loadFont(MANUAL_FONT);
 
-    btn = loadTexture(BLUE_BTN_PATH);
+    btn = getController().getResources().loadTexture(BLUE_BTN_PATH);
     goback.sprite = sf::Sprite(*btn);
     goback.text = "Continue";
     info = TEXT_BLOCK_INFO;
 
-    sfmlTexture = loadTexture(SFML_PATH);
+    sfmlTexture = getController().getResources().loadTexture(SFML_PATH);
     sfml = sf::Sprite(*sfmlTexture);
     sfml.setScale(0.7f, 0.7f);
     setOrigin(sfml, 0.60f, 0.60f);
@@ -81,8 +80,8 @@ public:
     screenDiv = windowSize.y / 4.0f;
 
     // Load sounds
-    buffer.loadFromFile(SHIELD_UP_SFX_PATH);
-    selectFX.setBuffer(buffer);
+    buffer = getController().getResources().load<sf::SoundBuffer>(SHIELD_UP_SFX_PATH);
+    selectFX.setBuffer(*buffer);
 
     inFocus = false;
 
@@ -151,7 +150,7 @@ public:
 
     surface.draw(sfml);
 
-    text.setFont(manual);
+    text.setFont(*manual);
     text.setPosition(sf::Vector2f(screenMid, 200));
     text.setFillColor(sf::Color::White);
     text.setString(info);
@@ -159,7 +158,7 @@ public:
 
     surface.draw(text);
 
-    text.setFont(font);
+    text.setFont(*font);
     text.setFillColor(sf::Color::Black);
     setOrigin(text, 0.5f, 0.5f);
     goback.draw(surface, text, screenMid, screenBottom - 40);
@@ -167,6 +166,4 @@ public:
 
   void onEnd() override {
   }
-
-  ~AboutScene() { delete btn; }
 };
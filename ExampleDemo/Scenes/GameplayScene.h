@@ -1,6 +1,5 @@
 #pragma once
 
-#include "../TextureLoader.h"
 #include "../Particle.h"
 #include "../ResourcePaths.h"
 #include "../SaveFile.h"
@@ -21,40 +20,40 @@ using namespace swoosh::types;
 
 class GameplayScene : public Activity {
 private:
-  sf::Texture* bgTexture;
+  std::shared_ptr<sf::Texture> bgTexture;
   sf::Sprite bg;
 
-  sf::Texture* playerTexture;
+  std::shared_ptr<sf::Texture> playerTexture;
   particle player;
   std::vector<particle> trails;
 
-  sf::Texture* enemyTexture;
+  std::shared_ptr<sf::Texture> enemyTexture;
   std::vector<particle> enemies;
 
-  sf::Texture * meteorBig, *meteorMed, *meteorSmall, *meteorTiny, *btn;
+  std::shared_ptr<sf::Texture> meteorBig, meteorMed, meteorSmall, meteorTiny, btn;
   std::vector<particle> meteors;
 
-  sf::Texture *laserTexture;
+  std::shared_ptr<sf::Texture> laserTexture;
   std::vector<particle> lasers;
 
-  sf::Texture * shieldTexture;
+  std::shared_ptr<sf::Texture> shieldTexture;
   sf::Sprite shield;
 
-  sf::Texture * extraLifeTexture;
+  std::shared_ptr<sf::Texture> extraLifeTexture;
   sf::Sprite star;
 
-  sf::Texture * numeralTexture[11];
-  sf::Texture * playerLifeTexture;
+  std::shared_ptr<sf::Texture> numeralTexture[11];
+  std::shared_ptr<sf::Texture> playerLifeTexture;
   sf::Sprite numeral;
   sf::Sprite playerLife;
 
-  sf::Font   font;
+  std::shared_ptr<sf::Font> font;
   sf::Text   text;
 
-  sf::SoundBuffer laserFX;
-  sf::SoundBuffer shieldFX;
-  sf::SoundBuffer gameOverFX;
-  sf::SoundBuffer extraLifeFX;
+  std::shared_ptr<sf::SoundBuffer> laserFX;
+  std::shared_ptr<sf::SoundBuffer> shieldFX;
+  std::shared_ptr<sf::SoundBuffer> gameOverFX;
+  std::shared_ptr<sf::SoundBuffer> extraLifeFX;
   sf::Sound laserChannel;
   sf::Sound shieldChannel;
   sf::Sound extraLifeChannel;
@@ -80,38 +79,40 @@ public:
     ingameMusic.setLoop(true);
     ingameMusic.setLoopPoints(sf::Music::TimeSpan(sf::seconds(0), sf::seconds(49)));
 
-    laserFX.loadFromFile(LASER1_SFX_PATH);
-    shieldFX.loadFromFile(SHIELD_DOWN_SFX_PATH);
-    gameOverFX.loadFromFile(LOSE_SFX_PATH);
-    extraLifeFX.loadFromFile(TWO_TONE_SFX_PATH);
+    ResourceCache& resources = getController().getResources();
+    laserFX = resources.load<sf::SoundBuffer>(LASER1_SFX_PATH);
+    shieldFX = resources.load<sf::SoundBuffer>(SHIELD_DOWN_SFX_PATH);
+    gameOverFX = resources.load<sf::SoundBuffer>(LOSE_SFX_PATH);
+    extraLifeFX = resources.load<sf::SoundBuffer>(TWO_TONE_SFX_PATH);
 
-    laserChannel.setBuffer(laserFX);
-    shieldChannel.setBuffer(shieldFX);
-    gameOverChannel.setBuffer(gameOverFX);
-    extraLifeChannel.setBuffer(extraLifeFX);
+    laserChannel.setBuffer(*laserFX);
+    shieldChannel.setBuffer(*shieldFX);
+    gameOverChannel.setBuffer(*gameOverFX);
+    extraLifeChannel.setBuffer(*extraLifeFX);
 
     sf::Vector2u windowSize = getController().getVirtualWindowSize();
     setView(windowSize);
 
-    bgTexture = loadTexture(PURPLE_BG_PATH);
+    // Cached textures are shared. Copy this one so repeating it does not change it for everyone else.
+    bgTexture = std::make_shared<sf::Texture>(*resources.loadTexture(PURPLE_BG_PATH));
     bgTexture->setRepeated(true);
     bg = sf::Sprite(*bgTexture);
     bg.setTextureRect({ 0, 0, (int)windowSize.x, (int)windowSize.y });
 
-    meteorBig = loadTexture(METEOR_BIG_PATH);
-    meteorMed = loadTexture(METEOR_MED_PATH);
-    meteorSmall = loadTexture(METEOR_SMALL_PATH);
-    meteorTiny = loadTexture(METEOR_TINY_PATH);
+    meteorBig = resources.loadTexture(METEOR_BIG_PATH);
+    meteorMed = resources.loadTexture(METEOR_MED_PATH);
+    meteorSmall = resources.loadTexture(METEOR_SMALL_PATH);
+    meteorTiny = resources.loadTexture(METEOR_TINY_PATH);
 
-    laserTexture = loadTexture(LASER_BEAM_PATH);
-    shieldTexture = loadTexture(SHIELD_LOW_PATH);
-    enemyTexture = loadTexture(ENEMY_PATH);
-    extraLifeTexture = loadTexture(EXTRA_LIFE_PATH);
+    laserTexture = resources.loadTexture(LASER_BEAM_PATH);
+    shieldTexture = resources.loadTexture(SHIELD_LOW_PATH);
+    enemyTexture = resources.loadTexture(ENEMY_PATH);
+    extraLifeTexture = resources.loadTexture(EXTRA_LIFE_PATH);
 
     star = sf::Sprite(*extraLifeTexture);
     setOrigin(star, 0.5, 0.5);
 
-    playerTexture = loadTexture(PLAYER_PATH);
+    playerTexture = resources.loadTexture(PLAYER_PATH);
     player.sprite = sf::Sprite(*playerTexture);
 
     setOrigin(player.sprite, 0.5, 0.5);
@@ -120,17 +121,17 @@ public:
     setOrigin(shield, 0.5, 0.5);
 
     for (int i = 0; i < 11; i++) {
-      numeralTexture[i] = loadTexture(NUMERAL_PATH[i]);
+      numeralTexture[i] = resources.loadTexture(NUMERAL_PATH[i]);
     }
 
-    playerLifeTexture = loadTexture(PLAYER_LIFE_PATH);
+    playerLifeTexture = resources.loadTexture(PLAYER_LIFE_PATH);
     playerLife = sf::Sprite(*playerLifeTexture);
 
     resetPlayer();
     alpha = 255.0; // resetPlayer() sets player alpha to 0, prevent that on first boot
 
-    font.loadFromFile(GAME_FONT);
-    text.setFont(font);
+    font = resources.loadFont(GAME_FONT);
+    text.setFont(*font);
 
     text.setFillColor(sf::Color::White); 
 
@@ -515,6 +516,4 @@ public:
   void onEnd() override {
     std::cout << "DemoScene OnEnd called" << std::endl;
   }
-
-  ~GameplayScene() { delete bgTexture;; }
 };
\ No newline at end of file
@@ -1,5 +1,4 @@
 #pragma once
-#include "../TextureLoader.h"
 #include "../Particle.h"
 #include "../Button.h"
 #include "../ResourcePaths.h"
@@ -21,15 +20,15 @@ class MainMenuScene;
 
 class HiScoreScene : public Activity {
 private:
-  sf::Texture * meteorBig, * meteorMed, * meteorSmall, * meteorTiny, * btn;
+  std::shared_ptr<sf::Texture> meteorBig, meteorMed, meteorSmall, meteorTiny, btn;
 
   std::vector<particle> meteors;
   button goback;
 
-  sf::Font   font;
+  std::shared_ptr<sf::Font> font;
   sf::Text   text;
 
-  sf::SoundBuffer buffer;
+  std::shared_ptr<sf::SoundBuffer> buffer;
   sf::Sound selectFX;
 
   save& hiscore;
@@ -40,7 +39,7 @@ private:
   float screenMid;
   float screenBottom;
 
-  Timer waitTime;
+  bool scrolling; // scores scroll up after waiting 3 seconds
   double scrollOffset;
 
   bool inFocus;
@@ -53,18 +52,18 @@ public:
     auto windowSize = getController().getVirtualWindowSize();
     setView(windowSize);
 
-    font.loadFromFile(GAME_FONT);
-    text.setFont(font);
+    font = getController().getResources().loadFont(GAME_FONT);
+    text.setFont(*font);
     text.setFillColor(sf::Color::White);
 
-    btn = loadTexture(BLUE_BTN_PATH);
+    btn = getController().getResources().loadTexture(BLUE_BTN_PATH);
     goback.sprite = sf::Sprite(*btn);
     goback.text = "Return";
 
-    meteorBig = loadTexture(METEOR_BIG_PATH);
-    meteorMed = loadTexture(METEOR_MED_PATH);
-    meteorSmall = loadTexture(METEOR_SMALL_PATH);
-    meteorTiny = loadTexture(METEOR_TINY_PATH);
+    meteorBig = getController().getResources().loadTexture(METEOR_BIG_PATH);
+    meteorMed = getController().getResources().loadTexture(METEOR_MED_PATH);
+    meteorSmall = getController().getResources().loadTexture(METEOR_SMALL_PATH);
+    meteorTiny = getController().getResources().loadTexture(METEOR_TINY_PATH);
 
     screenBottom = (float)windowSize.y;
     screenMid = windowSize.x / 2.0f;
@@ -75,12 +74,12 @@ public:
       hiscore.loadFromFile(SAVE_FILE_PATH);
     }
 
-    waitTime.start();
+    scrolling = false;
     scrollOffset = 0;
 
     // Load sounds
-    buffer.loadFromFile(SHIELD_UP_SFX_PATH);
-    selectFX.setBuffer(buffer);
+    buffer = getController().getResources().load<sf::SoundBuffer>(SHIELD_UP_SFX_PATH);
+    selectFX.setBuffer(*buffer);
 
     inFocus = false;
 
@@ -89,11 +88,15 @@ public:
 
   void onStart() override {
     inFocus = true;
+    waitToScroll();
   }
 
-  void onUpdate(double elapsed) override {
-    waitTime.update(sf::seconds(elapsed));
+  // Timers owned by this scene only count down while it is on top and are cancelled when it is deleted
+  void waitToScroll() {
+    getController().getTimers().after(this, sf::seconds(3), [this] { scrolling = true; });
+  }
 
+  void onUpdate(double elapsed) override {
     goback.update(getController().getWindow());
 
     if (goback.isClicked && inFocus) {
@@ -109,13 +112,14 @@ public:
     }
 
     // After 3 seconds, scroll up
-    if (waitTime.getElapsed().asSeconds() > 3) {
+    if (scrolling) {
 
       // If the scroll offset is greater than the height of all drawn scores
       if (scrollOffset > 200 + (hiscore.names.size() * 100)) {
         // We hit them all, reset
         scrollOffset = 0;
-        waitTime.reset();
+        scrolling = false;
+        waitToScroll();
       }
       else {
         scrollOffset += 100.0 * elapsed;
@@ -214,6 +218,4 @@ public:
 
   void onEnd() override {
   }
-
-  ~HiScoreScene() { delete btn; }
 };
@@ -3,10 +3,10 @@
 #include "GameplayScene.h"
 #include "HiscoreScene.h"
 #include "AboutScene.h"
-#include "../TextureLoader.h"
 #include "../Particle.h"
 #include "../Button.h"
 #include "../SaveFile.h"
+#include <cstring>
 
 // You can use any of the included segues in the actions below
 // to see what they look like! Start at line 170 in this source file!
@@ -54,16 +54,16 @@ using namespace swoosh::types;
 
 class MainMenuScene : public Activity {
 private:
-  sf::Texture* bgTexture;
-  sf::Texture* starTexture;
-  sf::Texture* blueButton, *redButton, *greenButton;
+  std::shared_ptr<sf::Texture> bgTexture;
+  std::shared_ptr<sf::Texture> starTexture;
+  std::shared_ptr<sf::Texture> blueButton, redButton, greenButton;
 
   sf::Sprite bg;
 
-  sf::Font menuFont;
+  std::shared_ptr<sf::Font> menuFont;
   sf::Text menuText;
 
-  sf::SoundBuffer buffer;
+  std::shared_ptr<sf::SoundBuffer> buffer;
   sf::Sound selectFX;
   sf::Music themeMusic;
 
@@ -86,18 +86,18 @@ public:
     inFocus = true;
     fadeMusic = false;
 
-    bgTexture = loadTexture(MENU_BG_PATH);
+    bgTexture = getController().getResources().loadTexture(MENU_BG_PATH);
     bg = sf::Sprite(*bgTexture);
 
-    starTexture = loadTexture(STAR_PATH);
+    starTexture = getController().getResources().loadTexture(STAR_PATH);
 
-    blueButton = loadTexture(BLUE_BTN_PATH);
-    redButton = loadTexture(RED_BTN_PATH);
-    greenButton = loadTexture(GREEN_BTN_PATH);
+    blueButton = getController().getResources().loadTexture(BLUE_BTN_PATH);
+    redButton = getController().getResources().loadTexture(RED_BTN_PATH);
+    greenButton = getController().getResources().loadTexture(GREEN_BTN_PATH);
 
-    menuFont.loadFromFile(GAME_FONT);
+    menuFont = getController().getResources().loadFont(GAME_FONT);
 
-    menuText.setFont(menuFont);
+    menuText.setFont(*menuFont);
     menuText.setFillColor(sf::Color::White);
 
     screenMid = getController().getWindow().getSize().x / 2.0f;
@@ -117,8 +117,8 @@ public:
     buttons.push_back(menuOption);
 
     // Load sounds
-    buffer.loadFromFile(SHIELD_UP_SFX_PATH);
-    selectFX.setBuffer(buffer);
+    buffer = getController().getResources().load<sf::SoundBuffer>(SHIELD_UP_SFX_PATH);
+    selectFX.setBuffer(*buffer);
     themeMusic.openFromFile(THEME_MUSIC_PATH);
 
     timer.start();
@@ -168,6 +168,8 @@ public:
         selectFX.play();
 
         if (b.text == PLAY_OPTION) {
+          // Gameplay loads a lot of media. Load it in the background while the menu keeps animating.
+          getController().prefetch<GameplayScene>(savefile);
           getController().push<segue<DreamCustom<50>, sec<3>>::to<GameplayScene>>(savefile);
           fadeMusic = true;
         }
@@ -301,17 +303,10 @@ public:
   }
 
   ~MainMenuScene() {
-    delete bgTexture;
-
     while (!particles.empty()) {
       particles.erase(particles.begin());
     }
 
-    delete starTexture;
-    delete blueButton;
-    delete greenButton;
-    delete redButton;
-
     savefile.writeToFile(SAVE_FILE_PATH);
   }
 };
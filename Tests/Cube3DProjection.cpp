@@ -0,0 +1,165 @@
+//This file checks that the Cube3D vertex shader puts every texel where the
+//per-pixel projection Cube3D used before drew it.
+//
+//Both shaders are mirrored here in C++ line for line. Each grid point is moved
+//by the vertex shader, then the old fragment shader is run at the resulting
+//screen position. It must sample the texel the grid point started from.
+//This covers both faces, their floor reflections, every direction, and the whole duration.
+//
+//Keep this in sync with src/Segues/Cube3D.h and the original projection below.
+//The GLSL itself is never compiled here, so a shader change that is not mirrored
+//below goes unnoticed. The segue_golden test renders the real shader.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+  struct vec2 {
+    double x, y;
+    vec2(double x = 0.0, double y = 0.0) : x(x), y(y) { }
+  };
+
+  vec2 operator+(vec2 a, vec2 b) { return vec2(a.x + b.x, a.y + b.y); }
+  vec2 operator-(vec2 a, vec2 b) { return vec2(a.x - b.x, a.y - b.y); }
+  vec2 operator*(vec2 a, vec2 b) { return vec2(a.x * b.x, a.y * b.y); }
+  vec2 operator/(vec2 a, vec2 b) { return vec2(a.x / b.x, a.y / b.y); }
+  vec2 operator+(vec2 a, double b) { return vec2(a.x + b, a.y + b); }
+  vec2 operator*(double a, vec2 b) { return vec2(a * b.x, a * b.y); }
+  vec2 operator/(vec2 a, double b) { return vec2(a.x / b, a.y / b); }
+  vec2 operator+(double a, vec2 b) { return b + a; }
+
+  double mix(double a, double b, double t) { return a * (1.0 - t) + b * t; }
+  double distance(double a, double b) { return std::abs(a - b); }
+
+  const double persp = 0.6;
+  const double unzoom = 0.7;
+  const double floating = 4.0;
+
+  double range(int direction, double time) {
+    return direction == 1 || direction == 2 ? 1.0 - time : time;
+  }
+
+  // Cube3D's fragment shader before it became a grid
+
+  vec2 project(vec2 p) {
+    p.y = 1.0 - p.y;
+    return p * vec2(1.0, -1.2) + vec2(0.0, -floating / 100.);
+  }
+
+  vec2 xskew(vec2 p, double persp, double center) {
+    double x = mix(p.x, 1.0 - p.x, center);
+    return (
+      (
+        vec2(x, (p.y - 0.5*(1.0 - persp) * x) / (1.0 + (persp - 1.0)*x))
+        - vec2(0.5 - distance(center, 0.5), 0.0)
+        )
+      * vec2(0.5 / distance(center, 0.5) * (center < 0.5 ? 1.0 : -1.0), 1.0)
+      + vec2(center < 0.5 ? 0.0 : 1.0, 0.0)
+      );
+  }
+
+  vec2 yskew(vec2 p, double persp, double center) {
+    vec2 y = xskew(p, persp, center);
+    return vec2(y.y, y.x);
+  }
+
+  // The texel the old shader drew at `pos` for one face, or its reflection
+  vec2 sample(vec2 pos, int direction, double time, int face, bool mirrored) {
+    double r = range(direction, time);
+    double uz = unzoom * 2.0*(0.5 - distance(0.5, r));
+    vec2 p = -uz * 0.5 + (1.0 + uz) * pos;
+    vec2 result;
+
+    if (direction > 1) {
+      p = vec2(p.y, p.x);
+
+      result = face == 0
+        ? yskew((p - vec2(r, 0.0)) / vec2(1.0 - r, 1.0), 1.0 - mix(r, 0.0, persp), 0.0)
+        : yskew(p / vec2(r, 1.0), mix(std::pow(r, 2.0), 1.0, persp), 1.0);
+    }
+    else {
+      result = face == 0
+        ? xskew((p - vec2(r, 0.0)) / vec2(1.0 - r, 1.0), 1.0 - mix(r, 0.0, persp), 0.0)
+        : xskew(p / vec2(r, 1.0), mix(std::pow(r, 2.0), 1.0, persp), 1.0);
+    }
+
+    if (mirrored) {
+      vec2 pfr = project(result);
+      result = vec2(pfr.x, 1.0 - pfr.y);
+    }
+
+    return result;
+  }
+
+  // Cube3D's vertex shader
+
+  vec2 unskew(vec2 a, double persp, double center) {
+    double x = mix(a.x, 1.0 - a.x, center);
+    return vec2(a.x, a.y * (1.0 + (persp - 1.0)*x) + 0.5*(1.0 - persp)*x);
+  }
+
+  // Where the vertex shader moves texel `t`
+  vec2 place(vec2 t, int direction, double time, int face, bool mirrored) {
+    double r = range(direction, time);
+    double uz = unzoom * 2.0*(0.5 - distance(0.5, r));
+    vec2 a = t;
+
+    if (mirrored) {
+      a = vec2(t.x, 1.0 + (1.0 + floating / 100. - t.y) / 1.2);
+    }
+
+    if (direction > 1) { a = vec2(a.y, a.x); }
+
+    vec2 p;
+
+    if (face == 0) {
+      vec2 q = unskew(a, 1.0 - mix(r, 0.0, persp), 0.0);
+      p = vec2(r + q.x * (1.0 - r), q.y);
+    }
+    else {
+      vec2 q = unskew(a, mix(std::pow(r, 2.0), 1.0, persp), 1.0);
+      p = vec2(q.x * r, q.y);
+    }
+
+    if (direction > 1) { p = vec2(p.y, p.x); }
+
+    return (p + uz * 0.5) / (1.0 + uz);
+  }
+}
+
+int main() {
+  const char* names[] = { "left", "right", "up", "down" };
+  const double tolerance = 1e-9;
+  int failures = 0;
+
+  for (int direction = 0; direction < 4; direction++) {
+    for (int face = 0; face < 2; face++) {
+      for (int mirrored = 0; mirrored < 2; mirrored++) {
+        double worst = 0.0;
+
+        // Face 1 is squashed to nothing at the very start and face 0 at the very end
+        for (int step = 1; step < 20; step++) {
+          double time = step / 20.0;
+
+          for (int i = 0; i <= 16; i++) {
+            for (int j = 0; j <= 16; j++) {
+              vec2 t(i / 16.0, j / 16.0);
+              vec2 pos = place(t, direction, time, face, mirrored != 0);
+              vec2 s = sample(pos, direction, time, face, mirrored != 0);
+
+              worst = std::max(worst, std::max(std::abs(s.x - t.x), std::abs(s.y - t.y)));
+            }
+          }
+        }
+
+        bool ok = worst < tolerance;
+        failures += ok ? 0 : 1;
+
+        std::printf("%-5s face %d %-9s max error %.3g %s\n", names[direction], face, mirrored ? "reflected" : "", worst, ok ? "ok" : "FAILED");
+      }
+    }
+  }
+
+  return failures ? 1 : 0;
+}
@@ -9,99 +9,77 @@ using namespace swoosh;
 /**
   @class BlurFadeIn
   @brief Blurs both screens and fades into the next while the last fades out
+
+  The blur runs at half resolution with separable passes so its cost stays flat at high resolutions.
   @warning COSTLY! For mobile, blurring will be turned off and it will be a simple fade
 */
 class BlurFadeIn : public Segue {
 private:
-  glsl::FastGaussianBlur shader;
-  sf::Texture last, next;
-  bool firstPass{ true };
+  glsl::DownsampledBlur shader;
 
-  const int kernels(const quality& mode) {
+  // kernel widths at half resolution cover the same radius the single pass blur used at full resolution
+  const int taps(const quality& mode) {
     switch (mode) {
     case quality::realtime:
-      return 60;
+      return 29;
     case quality::reduced:
-      return 30;
+      return 15;
     }
 
     // quality::mobile
-    return 10;
+    return 5;
   }
 
 public:
   void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::wideParabola(elapsed, duration, 1.0);
-    const bool optimized = getController().getRequestedQuality() == quality::mobile;
+    const quality mode = getController().getRequestedQuality();
+    const bool optimized = mode == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    shader.setPower((float)alpha * 8.f);
+    // the requested quality can change during the segue
+    shader.setTaps(taps(mode));
 
-    surface.clear(this->getLastActivityBGColor());
-    sf::Texture temp, temp2;
+    // the blur radius is in pixels of the captures which shrink with the render scale
+    shader.setPower(((float)alpha * 8.f + 1.f) * this->getRenderScale() - 1.f);
 
-    if (firstPass || !optimized) {
-      this->drawLastActivity(surface);
+    const sf::Texture& last = this->captureLastActivity(optimized);
+    const sf::Texture& next = this->captureNextActivity(optimized);
 
-      surface.display(); // flip and ready the buffer
-      last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = last;
-    }
+    surface.clear(sf::Color::Transparent);
+    alpha = ease::linear(elapsed, duration, 1.0);
 
-    shader.setTexture(&temp);
+    sf::Color lastColor(255, 255, 255, (sf::Uint8)(255.0 * (1-alpha)));
+    sf::Color nextColor(255, 255, 255, (sf::Uint8)(255.0 * alpha));
 
     if(useShader) {
+      // the blur is tinted by the sprite color so both passes can blend straight into the surface
+      shader.setTexture(&last);
+      shader.setColor(lastColor);
       shader.apply(surface);
-    }
-
-    surface.display();
-    temp = sf::Texture(surface.getTexture());
-
-    surface.clear(this->getNextActivityBGColor());
 
-    if (firstPass || !optimized) {
-      this->drawNextActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      next = temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
+      shader.setTexture(&next);
+      shader.setColor(nextColor);
+      shader.apply(surface);
     }
     else {
-      temp2 = next;
-    }
+      sf::Sprite sprite(last), sprite2(next);
+      sprite.setColor(lastColor);
+      sprite2.setColor(nextColor);
 
-    shader.setTexture(&temp2);
-
-    if(useShader) {
-      shader.apply(surface);
+      surface.draw(sprite);
+      surface.draw(sprite2);
     }
-
-    surface.display();
-    temp2 = sf::Texture(surface.getTexture());
-
-    sf::Sprite sprite, sprite2;
-    sprite.setTexture(temp);
-    sprite2.setTexture(temp2);
-
-    surface.clear(sf::Color::Transparent);
-    alpha = ease::linear(elapsed, duration, 1.0);
-
-    sprite.setColor(sf::Color(255, 255, 255, (sf::Uint8)(255.0 * (1-alpha))));
-    sprite2.setColor(sf::Color(255, 255, 255, (sf::Uint8)(255.0 * alpha)));
-
-    surface.draw(sprite);
-    surface.draw(sprite2);
-
-    firstPass = false;
   }
 
   BlurFadeIn(sf::Time duration, Activity* last, Activity* next) 
     // different kernels for each quality mode
-    : Segue(duration, last, next), shader(kernels(next->getController().getRequestedQuality())) {
-    /*...*/
+    : Segue(duration, last, next),
+      shader(next->getController().getSurfacePool(), glsl::DownsampledBlur::method::gaussian, taps(next->getController().getRequestedQuality())) {
+    // blurred captures lose nothing at lower resolutions
+    this->enableRenderScale();
   }
 
   ~BlurFadeIn() { ; }
@@ -2,6 +2,8 @@
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 #include <Swoosh/EmbedGLSL.h>
+#include <Swoosh/ShaderCache.h>
+#include <Swoosh/CpuCompositor.h>
 
 using namespace swoosh;
 
@@ -16,63 +18,46 @@ using namespace swoosh;
 template<int cols, int rows>
 class CheckerboardCustom : public Segue {
 private:
-  sf::Texture next, last;
-  sf::Shader shader;
-  bool firstPass{ true };
-  std::string checkerboardShader;
+  std::shared_ptr<sf::Shader> shader;
+  std::string_view checkerboardShader;
+  CpuCompositor compositor; //!< Draws the effect when shaders are disabled
 public:
   void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
+    const sf::Texture* last = &captureLastActivity(optimized);
+    const sf::Texture* next = &captureNextActivity(optimized);
 
-    if (firstPass || !optimized) {
-      drawLastActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-
-#ifdef __ANDROID__
-      temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-      temp.flip(true);
-#else
-      last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-#endif
-    }
-    else {
-      temp = last;
+    if (!useShader) {
+      compositor.read(*last, *next, this->getCaptureCount());
+      cpu::checkerboard(compositor, cols, rows, (float)alpha, 0.09f);
+      compositor.draw(surface);
+      return;
     }
-    sf::Sprite sprite(temp);
-
-    if (firstPass || !optimized) {
-      surface.clear(sf::Color::Transparent);
-      drawNextActivity(surface);
-
-      surface.display(); // flip and ready the buffer
 
 #ifdef __ANDROID__
-      temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-      temp2.flip(true);
-#else
-      next = temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
+    sf::Texture temp(*last), temp2(*next); // Make a copy of the source textures
+    temp.flip(true);
+    temp2.flip(true);
+    last = &temp;
+    next = &temp2;
 #endif
-    }
-    else {
-      temp2 = next;
-    }
 
-    shader.setUniform("progress", (float)alpha);
-    shader.setUniform("texture2", temp2);
-    shader.setUniform("texture", temp);
+    sf::Sprite sprite(*last);
 
-    sf::RenderStates states;
+    shader->setUniform("progress", (float)alpha);
+    shader->setUniform("texture2", *next);
+    shader->setUniform("texture", *last);
+    shader->setUniform("cols", cols);
+    shader->setUniform("rows", rows);
+    shader->setUniform("smoothness", 0.09f);
 
-    if(useShader) {
-      states.shader = &shader;
-    }
+    sf::RenderStates states;
+    states.shader = shader.get();
 
     surface.draw(sprite, states);
   }
@@ -134,11 +119,7 @@ public:
       );
 #endif
 
-    shader.loadFromMemory(checkerboardShader, sf::Shader::Fragment);
-
-    shader.setUniform("cols", cols);
-    shader.setUniform("rows", rows);
-    shader.setUniform("smoothness", 0.09f);
+    shader = ShaderCache::get(checkerboardShader);
   }
 
   ~CheckerboardCustom() {
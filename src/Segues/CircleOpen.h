@@ -3,6 +3,7 @@
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 #include <Swoosh/Shaders.h>
+#include <Swoosh/CpuCompositor.h>
 
 using namespace swoosh;
 
@@ -15,60 +16,36 @@ using namespace swoosh;
 class CircleOpen : public Segue {
 private:
   glsl::CircleMask shader;
-  sf::Texture next, last;
-  bool firstPass{ true };
+  CpuCompositor compositor; //!< Draws the effect when shaders are disabled
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
-
-    if (firstPass || !optimized) {
-      surface.clear(this->getNextActivityBGColor());
-      this->drawNextActivity(surface);
-      surface.display(); // flip and ready the buffer
-
-      next = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = next;
-    }
-
-    if (firstPass || !optimized) {
-      surface.clear(this->getLastActivityBGColor());
-      this->drawLastActivity(surface);
-      surface.display(); // flip and ready the buffer
-
-      last = temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp2 = last;
-    }
+    const sf::Texture& next = this->captureNextActivity(optimized);
+    const sf::Texture& last = this->captureLastActivity(optimized);
 
     sf::Vector2u size = getController().getWindow().getSize();
     float aspectRatio = (float)size.x / (float)size.y;
 
     shader.setAlpha((float)alpha);
     shader.setAspectRatio(aspectRatio);
-    shader.setTexture(&temp);
+    shader.setTexture(&next);
+
+    sf::Sprite right(last);
+    surface.draw(right);
 
     if(useShader) {
       shader.apply(surface);
     }
-
-    surface.display();
-    sf::Texture temp3(surface.getTexture());
-    sf::Sprite left(temp3);
-    sf::Sprite right(temp2);
-
-    surface.draw(right);
-    surface.draw(left);
-
-    firstPass = false;
+    else {
+      compositor.read(last, next, this->getCaptureCount());
+      cpu::circle(compositor, CpuCompositor::source::next, (float)alpha, aspectRatio);
+      compositor.draw(surface);
+    }
   }
 
   CircleOpen(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
@@ -16,60 +16,34 @@ using namespace swoosh;
 template<int percent_power> // from 0% - 100% 
 class CrossZoomCustom : public Segue {
 private:
-  sf::Texture next, last;
   glsl::CrossZoom shader;
-  bool firstPass{ true };
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
     const bool optimized = getController().isOptimizedForPerformance();
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
-
-    surface.clear(this->getLastActivityBGColor());
-
-    if (firstPass || !optimized) {
-      this->drawLastActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = last;
-    }
-
-    sf::Sprite sprite(temp);
-
-    surface.clear(this->getNextActivityBGColor());
-
-    if (firstPass || !optimized) {
-      this->drawNextActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-
-      next = temp2 = sf::Texture(surface.getTexture());
-    }
-    else {
-      temp2 = next;
-    }
+    const sf::Texture& last = this->captureLastActivity(optimized);
+    const sf::Texture& next = this->captureNextActivity(optimized);
   
     shader.setAlpha((float)alpha);
     shader.setPower((float)percent_power / 100.0f);
-    shader.setTexture1(&temp);
-    shader.setTexture2(&temp2);
+    shader.setTexture1(&last);
+    shader.setTexture2(&next);
 
     if(useShader) {
       shader.apply(surface);
     }
-
-    firstPass = false;
+    else {
+      surface.draw(sf::Sprite(next));
+    }
   }
 
   CrossZoomCustom(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
-    /* ... */
+    // the zoom smears the captures so they do not need full resolution
+    this->enableRenderScale();
   }
 
   ~CrossZoomCustom() { ; }
@@ -1,5 +1,7 @@
 #pragma once
 #include <Swoosh/EmbedGLSL.h>
+#include <Swoosh/ShaderCache.h>
+#include <Swoosh/MeshCache.h>
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 
@@ -8,227 +10,173 @@ using namespace swoosh;
 /**
   @class Cube3D
   @brief Projects the current and next scene on a 3D cube, rotating the cube to reveal the upcoming scene
-  @warning Even if optimized for slower hardware, may not be performant due to SFML bottlenecks
   @param direction. Compile-time enum constant that determines which direction to rotate the cube
 
+  Each face and its reflection is drawn as a static grid that the vertex shader moves into place.
+  The fragment shader only samples so the cost no longer grows with the number of pixels the cube covers.
+
   If optimized for mobile, will capture the scenes once and use less vertices to increase performance on weak hardware
 */
 template<types::direction direction>
 class Cube3D : public Segue {
 private:
-  sf::Texture last, next;
-  sf::Shader shader;
-  std::string cube3DShaderProgram;
-  bool firstPass{ true };
+  std::shared_ptr<sf::Shader> shader;
+  std::shared_ptr<const MeshCache::Grid> grid; //!< Unit grid shared by every Cube3D with the same quality
+  std::string_view cube3DVertexProgram;
+  std::string_view cube3DFragmentProgram;
+
+  const unsigned int subdivisions(const quality& mode) {
+    switch (mode) {
+    case quality::realtime:
+      return 32;
+    case quality::reduced:
+      return 16;
+    }
+
+    // quality::mobile
+    return 8;
+  }
+
+  void drawFace(sf::RenderTexture& surface, const sf::Texture& texture, int face, bool mirrored, const sf::BlendMode& blend) {
+    shader->setUniform("face", face);
+    shader->setUniform("mirrored", mirrored);
+    shader->setUniform("size", sf::Vector2f(texture.getSize()));
+
+    sf::RenderStates states;
+    states.shader = shader.get();
+    states.texture = &texture;
+    states.blendMode = blend;
+
+    grid->draw(surface, states);
+  }
 
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
-    const bool optimized = getController().getRequestedQuality() == quality::mobile;
+    const quality mode = getController().getRequestedQuality();
+    const bool optimized = mode == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
-
-    if (firstPass || !optimized) {
-      this->drawNextActivity(surface);
+    // the requested quality can change during the segue
+    const unsigned int cells = subdivisions(mode);
 
-      surface.display(); // flip and ready the buffer
-
-      next = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = next;
+    if (grid->getSize().x != cells) {
+      grid = MeshCache::grid(sf::Vector2u(cells, cells), 1);
     }
 
-    sf::Sprite sprite(temp);
+    const sf::Texture& next = this->captureNextActivity(optimized);
+    const sf::Texture& last = this->captureLastActivity(optimized);
 
-    if (firstPass || !optimized) {
-      this->drawLastActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-
-      last = temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp2 = last;
+    if (!useShader) {
+      surface.clear(getLastActivityBGColor());
+      surface.draw(sf::Sprite(next));
+      return;
     }
 
-    shader.setUniform("direction", static_cast<int>(direction));
+    const bool fromNext = direction == direction::right || direction == direction::up;
+    const sf::Texture& from = fromNext ? next : last;
+    const sf::Texture& to = fromNext ? last : next;
 
-    if (direction == direction::right || direction == direction::up) {
-      shader.setUniform("texture", temp);
-      shader.setUniform("texture2", temp2);
-    }
-    else {
-      shader.setUniform("texture2", temp);
-      shader.setUniform("texture", temp2);
-    }
+    shader->setUniform("direction", static_cast<int>(direction));
+    shader->setUniform("time", (float)alpha);
+    shader->setUniform("texture", sf::Shader::CurrentTexture);
 
-    shader.setUniform("time", (float)alpha);
+    surface.clear(sf::Color::Black);
 
-    sf::RenderStates states;
+    // Reflections on the floor add up underneath the faces
+    drawFace(surface, from, 0, true, sf::BlendAdd);
 
-    if(useShader) {
-      states.shader = &shader;
+    if (direction == direction::left || direction == direction::right) {
+      drawFace(surface, to, 1, true, sf::BlendAdd);
     }
 
-    surface.clear(getLastActivityBGColor());
-
-    surface.draw(sprite, states);
-
-    firstPass = false;
+    // The from face is drawn last so it wins where the two faces meet
+    drawFace(surface, to, 1, false, sf::BlendAlpha);
+    drawFace(surface, from, 0, false, sf::BlendAlpha);
   }
 
   Cube3D(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
     /* ... */
-    this->cube3DShaderProgram = GLSL(
+    // Moves each grid point to where the cube projection puts that texel of the face.
+    // This is the inverse of the per-pixel projection the cube used to run in the fragment shader.
+    this->cube3DVertexProgram = GLSL(
       110,
-      uniform sampler2D texture;
-      uniform sampler2D texture2;
       uniform float time;
       uniform int direction;
+      uniform vec2 size;
+      uniform int face;
+      uniform bool mirrored;
 
       const float persp = 0.6;
-      const float unzoom = 0.7;;
+      const float unzoom = 0.7;
       const float reflection = 0.4;
       const float floating = 4.0;
 
-      vec2 project(vec2 p) {
-        p.y = 1.0 - p.y;
-        return p * vec2(1.0, -1.2) + vec2(0.0, -floating / 100.);
-      }
-
-      bool inBounds(vec2 p) {
-        return all(lessThan(vec2(0.0), p)) && all(lessThan(p, vec2(1.0)));
-      }
-
-      // p : the position
+      // a : the skewed position
       // persp : the perspective in [ 0, 1 ]
-      // center : the xcenter in [0, 1] \ 0.5 excluded
-      vec2 xskew(vec2 p, float persp, float center) {
-        float x = mix(p.x, 1.0 - p.x, center);
-        return (
-          (
-            vec2(x, (p.y - 0.5*(1.0 - persp) * x) / (1.0 + (persp - 1.0)*x))
-            - vec2(0.5 - distance(center, 0.5), 0.0)
-            )
-          * vec2(0.5 / distance(center, 0.5) * (center < 0.5 ? 1.0 : -1.0), 1.0)
-          + vec2(center < 0.5 ? 0.0 : 1.0, 0.0)
-          );
-      }
-
-      vec2 yskew(vec2 p, float persp, float center) {
-        vec2 y = xskew(p, persp, center);
-        y = vec2(y.y, y.x);
-        return y;
-      }
-
-      vec4 bgColor(vec2 p, vec2 pfr, vec2 pto) {
-        vec4 c = vec4(0.0, 0.0, 0.0, 1.0);
-
-        pfr = project(pfr);
-
-        if (inBounds(pfr)) {
-          //if(true) {
-            /*float range = time;
-
-            if (direction == 2) { range = 1.0 - time; }
-
-            float uz = unzoom * 2.0*(0.5 - distance(0.5, range));
-            vec2 pos = -uz * 0.5 + (1.0 + uz) * p;
-
-            pos = vec2(pos.y, pos.x);
-
-            vec2 p2 = (pos - vec2(range, 0.0)) / vec2(1.0 - range, 1.0);
-            float persp2 = 1.0 - mix(range, 0.0, persp);
-            float center2 = 1.0;
-
-            float x = mix(p2.x, 1.0 - p2.x, center2);
-            pfr = (
-              (
-                vec2(x, (p2.y - 0.5*(1.0 - persp2) * x) / (1.0 + (persp2 - 1.0)*x))
-                - vec2(0.5 - distance(center2, 0.5), 0.0)
-                )
-              * vec2(0.5 / distance(center2, 0.5) * (center2 < 0.5 ? 1.0 : -1.0), 1.0)
-              + vec2(center2 < 0.5 ? 0.0 : 1.0, 0.0)
-              );
-
-            pfr = vec2(pfr.y, pfr.x);
-
-            pfr = project(pfr);*/
-
-          c += mix(vec4(0.0), texture2D(texture, vec2(pfr.x, 1.0 - pfr.y)), reflection * mix(1.0, 0.0, pfr.y));
-        }
-        pto = project(pto);
-        if (inBounds(pto) && direction < 2) {
-          c += mix(vec4(0.0), texture2D(texture2, vec2(pto.x, 1.0 - pto.y)), reflection * mix(1.0, 0.0, pto.y));
-        }
-        return c;
+      // center : the xcenter, 0 or 1
+      vec2 unskew(vec2 a, float persp, float center) {
+        float x = mix(a.x, 1.0 - a.x, center);
+        return vec2(a.x, a.y * (1.0 + (persp - 1.0)*x) + 0.5*(1.0 - persp)*x);
       }
 
       void main() {
-        vec2 pos = vec2(gl_TexCoord[0].x, gl_TexCoord[0].y);
-
-        vec4 from = texture2D(texture, pos.xy);
-        vec4 to = texture2D(texture2, pos.xy);
-        vec4 col = from;
-
         float range = time;
 
         if (direction == 1 || direction == 2) { range = 1.0 - time; }
 
         float uz = unzoom * 2.0*(0.5 - distance(0.5, range));
-        vec2 p = -uz * 0.5 + (1.0 + uz) * pos;
 
-        vec2 fromP;
-        vec2 toP;
+        vec2 t = (gl_TextureMatrix[0] * vec4(gl_MultiTexCoord0.xy * size, 0.0, 1.0)).xy;
+        vec2 a = t;
+        float weight = 1.0;
 
-        if (direction > 1) {
-          p = vec2(p.y, p.x);
+        if (mirrored) {
+          a = vec2(t.x, 1.0 + (1.0 + floating / 100. - t.y) / 1.2);
+          weight = reflection * t.y;
+        }
 
-          fromP = yskew(
-            (p - vec2(range, 0.0)) / vec2(1.0 - range, 1.0),
-            1.0 - mix(range, 0.0, persp),
-            0.0
-          );
+        if (direction > 1) { a = vec2(a.y, a.x); }
 
-          toP = yskew(
-            p / vec2(range, 1.0),
-            mix(pow(range, 2.0), 1.0, persp),
-            1.0
-          );
-        }
-        else {
-          fromP = xskew(
-            (p - vec2(range, 0.0)) / vec2(1.0 - range, 1.0),
-            1.0 - mix(range, 0.0, persp),
-            0.0
-          );
-
-          toP = xskew(
-            p / vec2(range, 1.0),
-            mix(pow(range, 2.0), 1.0, persp),
-            1.0
-          );
-        }
+        vec2 p;
 
-        if (inBounds(fromP)) {
-          col = texture2D(texture, fromP);
-        }
-        else if (inBounds(toP)) {
-          col = texture2D(texture2, toP);
+        if (face == 0) {
+          vec2 q = unskew(a, 1.0 - mix(range, 0.0, persp), 0.0);
+          p = vec2(range + q.x * (1.0 - range), q.y);
         }
         else {
-          col = bgColor(pos, fromP, toP);
+          vec2 q = unskew(a, mix(pow(range, 2.0), 1.0, persp), 1.0);
+          p = vec2(q.x * range, q.y);
         }
 
-        gl_FragColor = col;
+        if (direction > 1) { p = vec2(p.y, p.x); }
+
+        vec2 pos = (p + uz * 0.5) / (1.0 + uz);
+
+        // Back from texture space into the pixel space the sprite was drawn in
+        vec2 pixel = (pos - gl_TextureMatrix[0][3].xy) / vec2(gl_TextureMatrix[0][0][0], gl_TextureMatrix[0][1][1]);
+
+        gl_Position = gl_ProjectionMatrix * gl_ModelViewMatrix * vec4(pixel, 0.0, 1.0);
+        gl_TexCoord[0] = vec4(t, 0.0, 1.0);
+        gl_FrontColor = vec4(1.0, 1.0, 1.0, weight);
+      }
+    );
+
+    this->cube3DFragmentProgram = GLSL(
+      110,
+      uniform sampler2D texture;
+
+      void main() {
+        gl_FragColor = texture2D(texture, gl_TexCoord[0].xy) * gl_Color;
       }
     );
 
-    shader.loadFromMemory(this->cube3DShaderProgram, sf::Shader::Fragment);
+    shader = ShaderCache::get(this->cube3DVertexProgram, this->cube3DFragmentProgram);
+
+    const unsigned int cells = subdivisions(getController().getRequestedQuality());
+    grid = MeshCache::grid(sf::Vector2u(cells, cells), 1);
   }
 
   ~Cube3D() { }
@@ -1,6 +1,7 @@
 #pragma once
 #include <Swoosh/ActivityController.h>
 #include <Swoosh/EmbedGLSL.h>
+#include <Swoosh/ShaderCache.h>
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 
@@ -17,53 +18,35 @@ using namespace swoosh;
 */
 class DiamondTileCircle : public Segue {
 private:
-  sf::Shader shader;
-  std::string circleShader;
-  sf::Texture last, next;
-  bool firstPass{ true }, secondPass{ true };
+  std::shared_ptr<sf::Shader> shader;
+  std::string_view circleShader;
 
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::wideParabola(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp;
+    const sf::Texture* temp = nullptr;
 
     if (elapsed < duration * 0.5) {
-      if (firstPass || !optimized) {
-        this->drawLastActivity(surface);
-        surface.display(); // flip and ready the buffer
-        last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-        firstPass = false;
-      }
-      else {
-        temp = last;
-      }
+      temp = &this->captureLastActivity(optimized);
     }
     else {
-      if (secondPass || !optimized) {
-        this->drawNextActivity(surface);
-        surface.display(); // flip and ready the buffer
-        next = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-        secondPass = false;
-      }
-      else {
-        temp = next;
-      }
+      temp = &this->captureNextActivity(optimized);
     }
 
-    sf::Sprite sprite(temp);
+    sf::Sprite sprite(*temp);
 
-    shader.setUniform("texture", temp);
-    shader.setUniform("time", (float)alpha);
+    shader->setUniform("texture", *temp);
+    shader->setUniform("time", (float)alpha);
 
     sf::RenderStates states;
 
     if(useShader) {
-      states.shader = &shader;
+      states.shader = shader.get();
     }
 
     surface.draw(sprite, states);
@@ -105,7 +88,7 @@ public:
       }
     );
 
-    shader.loadFromMemory(circleShader, sf::Shader::Fragment);
+    shader = ShaderCache::get(circleShader);
   }
 
   ~DiamondTileCircle() { }
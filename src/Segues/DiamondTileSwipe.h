@@ -1,5 +1,7 @@
 #pragma once
 #include <Swoosh/EmbedGLSL.h>
+#include <Swoosh/ShaderCache.h>
+#include <Swoosh/CpuCompositor.h>
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 
@@ -17,54 +19,41 @@ using namespace swoosh;
 template<types::direction direction>
 class DiamondTileSwipe : public Segue {
 private:
-  sf::Texture last, next;
-  sf::Shader shader;
-  std::string diamondSwipeShaderProgram;
-  bool firstPass{ true }, secondPass{ true };
+  std::shared_ptr<sf::Shader> shader;
+  std::string_view diamondSwipeShaderProgram;
+  CpuCompositor compositor; //!< Draws the effect when shaders are disabled
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::wideParabola(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp;
+    const sf::Texture* temp = nullptr;
 
     if (elapsed < duration * 0.5) {
-      if (firstPass || !optimized) {
-        this->drawLastActivity(surface);
-        surface.display(); // flip and ready the buffer
-        last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-        firstPass = false;
-      }
-      else {
-        temp = last;
-      }
+      temp = &this->captureLastActivity(optimized);
     }
     else {
-      if (secondPass || !optimized) {
-        this->drawNextActivity(surface);
-        surface.display(); // flip and ready the buffer
-        next = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-        firstPass = false;
-      }
-      else {
-        temp = next;
-      }
+      temp = &this->captureNextActivity(optimized);
     }
 
-    sf::Sprite sprite(temp);
+    if (!useShader) {
+      compositor.read(*temp, this->getCaptureCount());
+      cpu::diamondTileSwipe(compositor, static_cast<int>(direction), (float)alpha);
+      compositor.draw(surface);
+      return;
+    }
 
-    shader.setUniform("texture", temp);
-    shader.setUniform("direction", static_cast<int>(direction));
-    shader.setUniform("time", (float)alpha);
+    sf::Sprite sprite(*temp);
 
-    sf::RenderStates states;
+    shader->setUniform("texture", *temp);
+    shader->setUniform("direction", static_cast<int>(direction));
+    shader->setUniform("time", (float)alpha);
 
-    if(useShader) {
-      states.shader = &shader;
-    }
+    sf::RenderStates states;
+    states.shader = shader.get();
 
     surface.draw(sprite, states);
   }
@@ -118,7 +107,7 @@ public:
       }
     );
 
-    shader.loadFromMemory(diamondSwipeShaderProgram, sf::Shader::Fragment);
+    shader = ShaderCache::get(diamondSwipeShaderProgram);
   }
 
   ~DiamondTileSwipe() { }
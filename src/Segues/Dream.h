@@ -1,8 +1,10 @@
 #pragma once
 #include <Swoosh/EmbedGLSL.h>
+#include <Swoosh/ShaderCache.h>
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 #include <Swoosh/Shaders.h>
+#include <Swoosh/CpuCompositor.h>
 
 using namespace swoosh;
 
@@ -16,57 +18,38 @@ using namespace swoosh;
 template<int wiggle_power>
 class DreamCustom : public Segue {
 private:
-  std::string shaderProgram;
-  sf::Shader shader;
-  sf::Texture last, next;
-  bool firstPass{ true };
+  std::string_view shaderProgram;
+  std::shared_ptr<sf::Shader> shader;
+  CpuCompositor compositor; //!< Draws the effect when shaders are disabled
 
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
+    const sf::Texture& last = this->captureLastActivity(optimized);
+    const sf::Texture& next = this->captureNextActivity(optimized);
 
-    if (firstPass || !optimized) {
-      surface.clear(this->getLastActivityBGColor());
-      this->drawLastActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = last;
-    }
-
-    if (firstPass || !optimized) {
-      surface.clear(this->getNextActivityBGColor());
-      this->drawNextActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      next = temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp2 = next;
+    if (!useShader) {
+      compositor.read(last, next, this->getCaptureCount());
+      cpu::dream(compositor, (float)alpha, wiggle_power);
+      compositor.draw(surface);
+      return;
     }
 
-    shader.setUniform("texture", temp);
-    shader.setUniform("texture2", temp2);
-    shader.setUniform("alpha", (float)alpha);
+    shader->setUniform("texture", last);
+    shader->setUniform("texture2", next);
+    shader->setUniform("alpha", (float)alpha);
+    shader->setUniform("power", wiggle_power);
 
     sf::RenderStates states;
-    
-    if(useShader) {
-      states.shader = &shader;
-    }
+    states.shader = shader.get();
 
-    sf::Sprite sprite(temp2); // dummy. we just need something with the screen size to draw with
+    sf::Sprite sprite(next); // dummy. we just need something with the screen size to draw with
     surface.draw(sprite, states);
-
-    firstPass = false;
   }
 
  DreamCustom(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
@@ -88,8 +71,7 @@ public:
         }
     );
 
-    shader.loadFromMemory(shaderProgram, sf::Shader::Fragment);
-    shader.setUniform("power", wiggle_power);
+    shader = ShaderCache::get(shaderProgram);
   }
 
   ~DreamCustom() { }
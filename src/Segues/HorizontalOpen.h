@@ -17,15 +17,11 @@ private:
 
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
 
-    this->drawLastActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-    sf::Texture temp(surface.getTexture()); // Make a copy of the source texture
+    const sf::Texture& temp = this->captureLastActivity(false);
 
     sf::Sprite top(temp); 
     top.setTextureRect(sf::IntRect(0, 0, windowSize.x, (int)(windowSize.y / 2.0)));
@@ -35,12 +31,7 @@ public:
     bottom.setTextureRect(sf::IntRect(0, (int)(windowSize.y / 2.0), windowSize.x, windowSize.y));
     bottom.setPosition(0.0f, (float)(windowSize.y/2.0f) +  ((float)alpha * (bottom.getTextureRect().height-bottom.getTextureRect().top)));
 
-    surface.clear();
-
-    this->drawNextActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-    sf::Texture temp2(surface.getTexture());
+    const sf::Texture& temp2 = this->captureNextActivity(false);
     sf::Sprite right(temp2);
 
     surface.draw(right);
@@ -17,15 +17,11 @@ private:
   int direction;
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = 1.0 - ease::bezierPopOut(elapsed, duration);
 
-    this->drawLastActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-    sf::Texture temp(surface.getTexture()); // Make a copy of the source texture
+    const sf::Texture& temp = this->captureLastActivity(false);
 
     sf::Sprite top(temp); 
     top.setTextureRect(sf::IntRect(0, 0, windowSize.x, windowSize.y / 2));
@@ -35,13 +31,7 @@ public:
     bottom.setTextureRect(sf::IntRect(0, windowSize.y / 2, windowSize.x, windowSize.y));
     bottom.setPosition((float)(direction * -alpha * bottom.getTexture()->getSize().x), (float)(windowSize.y/2.0f));
 
-    surface.clear();
-
-    this->drawNextActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-    sf::Texture temp2(surface.getTexture());
+    const sf::Texture& temp2 = this->captureNextActivity(false);
     sf::Sprite right(temp2);
 
     surface.draw(right);
@@ -15,50 +15,28 @@ using namespace swoosh;
 class Morph : public Segue {
 private:
   glsl::Morph shader;
-  sf::Texture last, next;
-  bool firstPass{ true };
 
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
-
-    if (firstPass || !optimized) {
-      surface.clear(this->getLastActivityBGColor());
-      this->drawLastActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = last;
-    }
-
-    if (firstPass || !optimized) {
-      surface.clear(this->getNextActivityBGColor());
-      this->drawNextActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      next = temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp2 = next;
-    }
+    const sf::Texture& last = this->captureLastActivity(optimized);
+    const sf::Texture& next = this->captureNextActivity(optimized);
 
     shader.setAlpha((float)alpha);
-    shader.setTexture1(&temp);
-    shader.setTexture2(&temp2);
+    shader.setTexture1(&last);
+    shader.setTexture2(&next);
 
     if(useShader) {
       shader.apply(surface);
     }
-
-    firstPass = false;
+    else {
+      surface.draw(sf::Sprite(next));
+    }
   }
 
   Morph(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
@@ -17,8 +17,6 @@ using namespace swoosh;
 class PageTurn : public Segue {
 private:
   glsl::PageTurn shader;
-  sf::Texture last, next;
-  bool firstPass{ true };
 
   const int cellsize(const quality& mode) {
     switch (mode) {
@@ -34,56 +32,31 @@ private:
 
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
-    const bool optimized = getController().getRequestedQuality() == quality::mobile;
+    const quality mode = getController().getRequestedQuality();
+    const bool optimized = mode == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
+    // the requested quality can change during the segue
+    shader.setCellSize(cellsize(mode));
 
-    surface.clear(this->getLastActivityBGColor());
+    const sf::Texture& last = this->captureLastActivity(optimized);
+    const sf::Texture& next = this->captureNextActivity(optimized);
 
-    if (firstPass || !optimized) {
-      this->drawLastActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = last;
-    }
-
-    shader.setTexture(&temp);
+    shader.setTexture(&last);
     shader.setAlpha((float)alpha);
 
+    // The next scene is revealed underneath the turning page
+    surface.draw(sf::Sprite(next));
+
     if(useShader) {
       shader.apply(surface);
     }
-
-    surface.display(); 
-
-    sf::Texture copy(surface.getTexture());
-    sf::Sprite left(copy); // Make a copy of the effect to render later
-
-    surface.clear(this->getNextActivityBGColor());
-
-    if (firstPass || !optimized) {
-      this->drawNextActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      next = temp2 = sf::Texture(surface.getTexture());
-    }
     else {
-      temp2 = next;
+      surface.draw(sf::Sprite(last));
     }
-
-    sf::Sprite right(temp2);
-
-    surface.draw(right);
-    surface.draw(left);
-
-    firstPass = false;
   }
 
   PageTurn(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next),
@@ -15,53 +15,32 @@ using namespace swoosh;
 class PixelateBlackWashFade : public Segue {
 private:
   glsl::Pixelate shader;
-  sf::Texture last, next;
-  bool firstPass{ true };
-  bool secondPass{ true };
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::wideParabola(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp;
+    const sf::Texture* temp = nullptr;
 
     if (elapsed <= duration * 0.5) {
-      if (firstPass || !optimized) {
-        surface.clear(this->getLastActivityBGColor());
-        this->drawLastActivity(surface);
-        surface.display();
-        last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-
-        firstPass = false;
-      }
-      else {
-        temp = last;
-      }
+      temp = &this->captureLastActivity(optimized);
     }
     else {
-      if (secondPass || !optimized) {
-        surface.clear(this->getNextActivityBGColor());
-        this->drawNextActivity(surface);
-        surface.display();
-        next = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-
-        secondPass = false;
-      }
-      else {
-        temp = next;
-      }
+      temp = &this->captureNextActivity(optimized);
     }
 
-
-    shader.setTexture(&temp);
+    shader.setTexture(temp);
     shader.setThreshold((float)alpha/15.0f);
 
     if(useShader) {
       shader.apply(surface);
     }
+    else {
+      surface.draw(sf::Sprite(*temp));
+    }
 
     // 10% of segue is a pixelate before darkening
     double delay = (duration / 10.0);
@@ -76,6 +55,8 @@ public:
   }
 
   PixelateBlackWashFade(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
+    // the captures are pixelated so they do not need full resolution
+    this->enableRenderScale();
   }
 
   ~PixelateBlackWashFade() { ; }
@@ -3,6 +3,7 @@
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 #include <Swoosh/Shaders.h>
+#include <Swoosh/CpuCompositor.h>
 
 using namespace swoosh;
 
@@ -16,52 +17,30 @@ using namespace swoosh;
 class RadialCCW : public Segue {
 private:
   glsl::RadialCCW shader;
-  sf::Texture next, last;
-  bool firstPass{ true };
+  CpuCompositor compositor; //!< Draws the effect when shaders are disabled
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
+    const sf::Texture& last = this->captureLastActivity(optimized);
+    const sf::Texture& next = this->captureNextActivity(optimized);
 
-    surface.clear(this->getLastActivityBGColor());
-
-    if (firstPass || !optimized) {
-      this->drawLastActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-
-      last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = last;
-    }
-
-    surface.clear(this->getNextActivityBGColor());
-
-    if (firstPass || !optimized) {
-      this->drawNextActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-      next = temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp2 = next;
-    }
-
-    shader.setTexture1(&temp);
-    shader.setTexture2(&temp2);
+    shader.setTexture1(&last);
+    shader.setTexture2(&next);
     shader.setAlpha((float)alpha);
 
     if(useShader) {
       shader.apply(surface);
     }
-
-    firstPass = false;
+    else {
+      compositor.read(last, next, this->getCaptureCount());
+      cpu::radialCCW(compositor, (float)alpha);
+      compositor.draw(surface);
+    }
   }
 
   RadialCCW(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
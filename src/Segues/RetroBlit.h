@@ -20,70 +20,43 @@ template<int krows, int kcols>
 class RetroBlitCustom : public Segue {
 private:
   glsl::RetroBlit shader;
-  sf::Texture last, next;
-  bool firstPass{ true };
-  bool secondPass{ true };
 public:
   virtual void onDraw(sf::RenderTexture& surface) {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp;
+    const sf::Texture* temp = nullptr;
 
     if (alpha <= 0.5) {
-      if (firstPass || !optimized) {
-        this->drawLastActivity(surface);
+      temp = &this->captureLastActivity(optimized);
+      surface.clear(this->getLastActivityBGColor());
 
-        surface.display(); // flip and ready the buffer
-
-        last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-        surface.clear(this->getLastActivityBGColor());
-      }
-      else {
-        temp = last;
-      }
-
-      shader.setTexture(&temp);
+      shader.setTexture(temp);
       shader.setAlpha((0.5f - (float)alpha)/0.5f);
-
-      if(useShader) {
-        shader.apply(surface);
-      }
-
-      firstPass = false;
     }
     else {
-      if (secondPass || !optimized) {
-        this->drawNextActivity(surface);
-
-        surface.display(); // flip and ready the buffer
-
-        next = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-        sf::Sprite sprite(temp);
+      temp = &this->captureNextActivity(optimized);
+      surface.clear(this->getNextActivityBGColor());
 
-        surface.clear(this->getNextActivityBGColor());
-      }
-      else {
-        temp = next;
-      }
-
-      shader.setTexture(&temp);
+      shader.setTexture(temp);
       shader.setAlpha(((float)alpha - 0.5f) / 0.5f);
+    }
 
-      if(useShader) {
-        shader.apply(surface);
-      }
-
-      secondPass = false;
+    if(useShader) {
+      shader.apply(surface);
+    }
+    else {
+      surface.draw(sf::Sprite(*temp));
     }
   }
 
   RetroBlitCustom(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next),
     shader(kcols, krows) {
-    /* ... */;
+    // the captures are dithered into cells so they do not need full resolution
+    this->enableRenderScale();
   }
 
   ~RetroBlitCustom() { ; }
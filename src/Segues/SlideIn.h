@@ -17,15 +17,11 @@ class SlideIn : public Segue {
 public:
 
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
 
-    this->drawLastActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-    sf::Texture temp(surface.getTexture()); // Make a copy of the source texture
+    const sf::Texture& temp = this->captureLastActivity(false);
 
     sf::Sprite left(temp); 
 
@@ -37,12 +33,7 @@ public:
     if (direction == direction::up   ) ud = -1;
     if (direction == direction::down ) ud = 1;
 
-    surface.clear();
-
-    this->drawNextActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-    sf::Texture temp2(surface.getTexture());
+    const sf::Texture& temp2 = this->captureNextActivity(false);
     sf::Sprite right(temp2);
 
     right.setPosition((float)-lr * (1.0f-(float)alpha) * right.getTexture()->getSize().x, (float)-ud * (1.0f-(float)alpha) * right.getTexture()->getSize().y);
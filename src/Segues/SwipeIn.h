@@ -19,25 +19,14 @@ private:
   sf::Vector2u windowSize;
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
 
-    surface.clear(this->getLastActivityBGColor());
-    this->drawLastActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-    sf::Texture temp(surface.getTexture()); // Make a copy of the source texture
-
+    const sf::Texture& temp = this->captureLastActivity(false);
     sf::Sprite bottom(temp); 
-    surface.clear();
-
-    surface.clear(this->getLastActivityBGColor());
-    this->drawNextActivity(surface);
 
-    surface.display(); // flip and ready the buffer
-    sf::Texture temp2(surface.getTexture());
+    const sf::Texture& temp2 = this->captureNextActivity(false);
     sf::Sprite top(temp2);
 
     int l = 0;
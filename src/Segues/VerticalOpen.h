@@ -18,15 +18,11 @@ private:
   sf::Vector2u windowSize;
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
 
-    this->drawLastActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-
-    sf::Texture temp(surface.getTexture()); // Make a copy of the source texture
+    const sf::Texture& temp = this->captureLastActivity(false);
 
     sf::Sprite left(temp); 
     left.setTextureRect(sf::IntRect(0, 0, (int)(windowSize.x/2.0f), windowSize.y));
@@ -36,12 +32,7 @@ public:
     right.setTextureRect(sf::IntRect((int)(windowSize.x/2.0f), 0, windowSize.x, windowSize.y));
     right.setPosition((float)(windowSize.x/2.0f) + ((float)alpha * (right.getTextureRect().width-right.getTextureRect().left)), 0.0f);
 
-    surface.clear();
-
-    this->drawNextActivity(surface);
-
-    surface.display(); // flip and ready the buffer
-    sf::Texture temp2(surface.getTexture());
+    const sf::Texture& temp2 = this->captureNextActivity(false);
     sf::Sprite next(temp2);
 
     surface.draw(next);
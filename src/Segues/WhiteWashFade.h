@@ -14,8 +14,8 @@ using namespace swoosh;
 class WhiteWashFade : public Segue {
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::wideParabola(elapsed, duration, 1.0);
 
     if (elapsed <= duration * 0.5)
@@ -2,6 +2,7 @@
 #include <Swoosh/Segue.h>
 #include <Swoosh/Ease.h>
 #include <Swoosh/EmbedGLSL.h>
+#include <Swoosh/ShaderCache.h>
 
 using namespace swoosh;
 
@@ -13,59 +14,32 @@ using namespace swoosh;
 */
 class ZoomFadeIn : public Segue {
 private:
-  std::string zoomShaderProgram;
-  sf::Shader shader;
-  sf::Texture next, last;
-  bool firstPass{ true };
+  std::string_view zoomShaderProgram;
+  std::shared_ptr<sf::Shader> shader;
 public:
  void onDraw(sf::RenderTexture& surface) override {
-    double elapsed = getElapsed().asMilliseconds();
-    double duration = getDuration().asMilliseconds();
+    double elapsed = getElapsed().asMicroseconds();
+    double duration = getDuration().asMicroseconds();
     double alpha = ease::linear(elapsed, duration, 1.0);
     const bool optimized = getController().getRequestedQuality() == quality::mobile;
     const bool useShader = getController().isShadersEnabled();
 
-    sf::Texture temp, temp2;
+    const sf::Texture& last = this->captureLastActivity(optimized);
+    const sf::Texture& next = this->captureNextActivity(optimized);
 
-    if (firstPass || !optimized) {
-      this->drawLastActivity(surface);
+    sf::Sprite sprite(last);
 
-      surface.display(); // flip and ready the buffer
-
-      last = temp = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp = last;
-    }
-
-    sf::Sprite sprite(temp);
-
-    surface.clear(sf::Color::Transparent);
-
-    if (firstPass || !optimized) {
-      this->drawNextActivity(surface);
-
-      surface.display(); // flip and ready the buffer
-
-      next = temp2 = sf::Texture(surface.getTexture()); // Make a copy of the source texture
-    }
-    else {
-      temp2 = next;
-    }
-
-    shader.setUniform("progress", (float)alpha);
-    shader.setUniform("texture2", temp2);
-    shader.setUniform("texture", temp);
+    shader->setUniform("progress", (float)alpha);
+    shader->setUniform("texture2", next);
+    shader->setUniform("texture", last);
 
     sf::RenderStates states;
 
     if(useShader) {
-      states.shader = &shader;
+      states.shader = shader.get();
     }
 
     surface.draw(sprite, states);
-
-    firstPass = false;
   }
 
   ZoomFadeIn(sf::Time duration, Activity* last, Activity* next) : Segue(duration, last, next) {
@@ -90,7 +64,7 @@ public:
       }
     );
  
-    shader.loadFromMemory(zoomShaderProgram, sf::Shader::Fragment);
+    shader = ShaderCache::get(zoomShaderProgram);
   }
 
   ~ZoomFadeIn() { ; }
@@ -1,6 +1,15 @@
 #pragma once
+#include "WorkerPool.h"
 #include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace swoosh {
 
@@ -9,8 +18,10 @@ namespace swoosh {
   /**
   @class ActionItem
 
-  Your standard ActionItem is non-blocking and seemingly runs concurrent with your other 
+  Your standard ActionItem is non-blocking and seemingly runs concurrent with your other
   non-blocking action items
+
+  Items that set `isThreadSafe` in their constructor really can run concurrently. See: ActionList::update()
   */
   class ActionItem {
     friend class ActionList;
@@ -20,27 +31,33 @@ namespace swoosh {
 
   protected:
     bool isBlocking;
+    bool isThreadSafe; //!< update() only touches this item's own state and may run on a worker thread
 
   private:
     bool isDoneFlag;
-    std::size_t index;
+    std::uint32_t slot; //!< Where the owning list keeps this item
     ActionList *list;
 
   public:
-    ActionItem() { isBlocking = isDoneFlag = false; index = -1; list = nullptr; }
+    ActionItem() { isBlocking = isThreadSafe = isDoneFlag = false; slot = static_cast<std::uint32_t>(-1); list = nullptr; }
     virtual ~ActionItem() {};
 
     virtual void update(sf::Time elapsed) = 0;
     virtual void draw(sf::RenderTexture& surface) = 0;
     void markDone() { isDoneFlag = true; }
     const bool isDone() const { return isDoneFlag; }
-    const std::size_t getIndex() const { return index; }
+
+    /**
+      @brief Query the position of this item in its list
+      @warning This walks the list from the front. Prefer keeping the ActionList::Handle
+    */
+    inline const std::size_t getIndex() const;
   };
 
   /**
   @class BlockingActionItem
   When the action list reaches a BlockingActionItem the action list stops iterating.
-  Only until the blocking action item is marked for cleanup using `markDone()` 
+  Only until the blocking action item is marked for cleanup using `markDone()`
   will the action list continue passed.
   */
 
@@ -60,6 +77,70 @@ namespace swoosh {
   class ClearAllActions;
   class ConditionalBranchListAction;
 
+  /**
+  @class ActionArena
+  @brief Recycling memory for action items constructed with ActionList::emplace()
+
+  Memory is carved out of fixed blocks. Freed memory is kept in a free list per size
+  so scripts that keep queueing the same kinds of actions stop touching the heap once warmed up.
+  */
+  class ActionArena {
+  public:
+    static constexpr std::size_t blockSize = 16 * 1024;
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+
+  private:
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+    std::size_t used{ blockSize }; //!< Bytes handed out from the newest block
+    std::vector<std::vector<void*>> freeLists; //!< Freed memory indexed by size class
+
+    static std::size_t sizeClass(std::size_t bytes) {
+      return (bytes + granularity - 1) / granularity;
+    }
+
+  public:
+    ActionArena() = default;
+    ActionArena(const ActionArena& rhs) = delete;
+    ActionArena& operator=(const ActionArena& rhs) = delete;
+
+    /**
+      @brief Query if an object of this size and alignment can come from the arena
+    */
+    static constexpr bool fits(std::size_t bytes, std::size_t alignment) {
+      return bytes <= blockSize && alignment <= granularity;
+    }
+
+    void* allocate(std::size_t bytes) {
+      std::size_t cls = sizeClass(bytes);
+
+      if (cls < freeLists.size() && !freeLists[cls].empty()) {
+        void* memory = freeLists[cls].back();
+        freeLists[cls].pop_back();
+        return memory;
+      }
+
+      std::size_t rounded = cls * granularity;
+
+      if (used + rounded > blockSize) {
+        blocks.emplace_back(new unsigned char[blockSize]);
+        used = 0;
+      }
+
+      void* memory = blocks.back().get() + used;
+      used += rounded;
+      return memory;
+    }
+
+    void deallocate(void* memory, std::size_t bytes) {
+      std::size_t cls = sizeClass(bytes);
+
+      if (cls >= freeLists.size()) {
+        freeLists.resize(cls + 1);
+      }
+
+      freeLists[cls].push_back(memory);
+    }
+  };
 
   /**
   @class ActionList
@@ -74,107 +155,430 @@ namespace swoosh {
 
   All dynamic memory shared with the action list is `deleted`
   at cleanup and when an item is marked done using `markDone()`
+
+  Items live in a slot array linked in list order. Adding, inserting next to a handle, and
+  removing finished items are O(1) and never shift other items. Finished items are unlinked
+  in the same pass that updates the list. Items built with `emplace()` live in the list's arena
+  instead of being allocated one by one.
+
+  Consecutive non-blocking items marked `isThreadSafe` are updated together on a WorkerPool
+  once there are enough of them to be worth it. The list waits for the whole run before moving on
+  so blocking items still see every item before them updated.
   */
 
   class ActionList {
+    friend class ActionItem;
     friend class ClearPreviousActions;
     friend class ClearAllActions;
     friend class ConditionalBranchListAction;
+
+  public:
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+    /**
+      @class Handle
+      @brief Refers to an item in the list. Handles to items that were removed are safely ignored.
+
+      Handles belong to the list that returned them. Items moved into another list by `append()`
+      or `insert(pos, ActionList*)` get new handles in that list.
+    */
+    class Handle {
+      friend class ActionList;
+
+      std::uint32_t slot{ npos };
+      std::uint32_t generation{};
+
+      Handle(std::uint32_t slot, std::uint32_t generation) : slot(slot), generation(generation) { }
+
+    public:
+      Handle() = default;
+    };
+
   private:
-    std::vector<ActionItem*> items;
+    struct Slot {
+      ActionItem* item{ nullptr };
+      void* storage{ nullptr }; //!< Start of the arena memory. nullptr if the item was allocated with `new`
+      ActionArena* arena{ nullptr }; //!< Arena the storage came from
+      std::size_t bytes{}; //!< Size of the arena memory
+      void (*destroy)(void*){ nullptr }; //!< Runs the item's destructor in place
+      std::uint32_t prev{ npos }, next{ npos }; //!< Links in list order or the free list
+      std::uint32_t generation{}; //!< Bumped every time the slot is freed so old handles go stale
+    };
+
+    std::vector<Slot> slots;
+    std::uint32_t head{ npos }, tail{ npos };
+    std::uint32_t freeHead{ npos };
+    std::size_t count{};
+    std::shared_ptr<ActionArena> arena; //!< Created on the first emplace()
+    std::vector<std::shared_ptr<ActionArena>> adopted; //!< Arenas of other lists whose items were moved here
     bool clearFlag;
-  public:
-    void updateIndexesFrom(std::size_t pos) {
-      for (pos; pos < items.size(); pos++) {
-        items[pos]->index++;
+    WorkerPool* pool{ nullptr }; //!< nullptr uses WorkerPool::shared()
+    std::size_t parallelThreshold{ 32 }; //!< Shorter thread safe runs are updated on the calling thread
+    std::vector<ActionItem*> run; //!< Reused every update to collect a thread safe run
+
+    /**
+      @brief Collects the thread safe non-blocking items starting at `i` into `run` and updates them all
+      @return the first slot after the run
+
+      Items in the run never change the list so they can run in any order. Items they mark done are
+      removed on the next update in list order, the same as if they had run one by one.
+    */
+    std::uint32_t updateRun(std::uint32_t i, sf::Time elapsed) {
+      run.clear();
+
+      while (i != npos) {
+        ActionItem* item = slots[i].item;
+
+        if (item->isDone()) {
+          std::uint32_t next = slots[i].next;
+          erase(i);
+          i = next;
+          continue;
+        }
+
+        if (item->isBlocking || !item->isThreadSafe) break;
+
+        run.push_back(item);
+        i = slots[i].next;
+      }
+
+      if (run.size() < parallelThreshold) {
+        for (ActionItem* item : run) {
+          item->update(elapsed);
+        }
+      }
+      else {
+        WorkerPool& workers = pool ? *pool : WorkerPool::shared();
+        workers.parallelFor(run.size(), [this, elapsed](std::size_t n) { run[n]->update(elapsed); });
       }
+
+      return i;
+    }
+
+    std::uint32_t allocateSlot() {
+      if (freeHead == npos) {
+        slots.emplace_back();
+        return static_cast<std::uint32_t>(slots.size() - 1);
+      }
+
+      std::uint32_t index = freeHead;
+      freeHead = slots[index].next;
+      return index;
+    }
+
+    /**
+      @brief Links the slot in front of `before`, or at the back if `before` is npos
+    */
+    void link(std::uint32_t index, std::uint32_t before) {
+      Slot& slot = slots[index];
+      slot.next = before;
+      slot.prev = before == npos ? tail : slots[before].prev;
+
+      if (slot.prev != npos) slots[slot.prev].next = index; else head = index;
+      if (slot.next != npos) slots[slot.next].prev = index; else tail = index;
+
+      count++;
     }
 
-    void insert(std::size_t pos, ActionItem* item) {
+    void unlink(std::uint32_t index) {
+      Slot& slot = slots[index];
+
+      if (slot.prev != npos) slots[slot.prev].next = slot.next; else head = slot.next;
+      if (slot.next != npos) slots[slot.next].prev = slot.prev; else tail = slot.prev;
+
+      slot.prev = slot.next = npos;
+      count--;
+    }
+
+    void releaseSlot(std::uint32_t index) {
+      Slot& slot = slots[index];
+      slot = Slot{ nullptr, nullptr, nullptr, 0, nullptr, npos, freeHead, slot.generation + 1u };
+      freeHead = index;
+    }
+
+    /**
+      @brief Unlinks the item and destroys it
+    */
+    void erase(std::uint32_t index) {
+      unlink(index);
+
+      Slot slot = slots[index];
+      releaseSlot(index);
+
+      if (slot.storage) {
+        slot.destroy(slot.storage);
+        slot.arena->deallocate(slot.storage, slot.bytes);
+      }
+      else {
+        delete slot.item;
+      }
+    }
+
+    Handle place(std::uint32_t before, ActionItem* item, void* storage, ActionArena* from, std::size_t bytes, void (*destroy)(void*)) {
+      std::uint32_t index = allocateSlot();
+      Slot& slot = slots[index];
+      slot.item = item;
+      slot.storage = storage;
+      slot.arena = from;
+      slot.bytes = bytes;
+      slot.destroy = destroy;
+
       item->list = this;
-      items.insert(items.begin() + pos, item);
-      item->index = pos;
-      updateIndexesFrom(pos);
+      item->slot = index;
+      link(index, before);
+      return Handle(index, slot.generation);
+    }
+
+    Handle place(std::uint32_t before, ActionItem* item) {
+      return place(before, item, nullptr, nullptr, 0, nullptr);
+    }
+
+    /**
+      @brief Moves every item of `other` in front of `before` and leaves `other` empty
+
+      The items are adopted in one pass over `other` and the run is linked into place with one splice.
+    */
+    void splice(std::uint32_t before, ActionList& other) {
+      if (&other == this || other.head == npos) return;
+
+      std::uint32_t first = npos, last = npos;
+      std::size_t moved = 0;
+
+      for (std::uint32_t i = other.head; i != npos; i = other.slots[i].next) {
+        const Slot& from = other.slots[i];
+        std::uint32_t index = allocateSlot();
+        Slot& slot = slots[index];
+        slot.item = from.item;
+        slot.storage = from.storage;
+        slot.arena = from.arena;
+        slot.bytes = from.bytes;
+        slot.destroy = from.destroy;
+        slot.prev = last;
+        slot.next = npos;
+        slot.item->list = this;
+        slot.item->slot = index;
+
+        if (last != npos) slots[last].next = index; else first = index;
+
+        last = index;
+        moved++;
+      }
+
+      // Link the run between `before` and the item ahead of it
+      std::uint32_t prev = before == npos ? tail : slots[before].prev;
+      slots[first].prev = prev;
+      slots[last].next = before;
+
+      if (prev != npos) slots[prev].next = first; else head = first;
+      if (before != npos) slots[before].prev = last; else tail = last;
+
+      count += moved;
+
+      // Arena items stay where they were built, so keep their arenas alive
+      if (other.arena) adopted.push_back(other.arena);
+      adopted.insert(adopted.end(), other.adopted.begin(), other.adopted.end());
+
+      other.forget();
+    }
+
+    /**
+      @brief Drops every item without destroying them. Used after the items were moved to another list.
+    */
+    void forget() {
+      slots.clear();
+      head = tail = freeHead = npos;
+      count = 0;
     }
 
+    /**
+      @return the slot at position `pos` or npos if `pos` is the end of the list
+    */
+    std::uint32_t slotAt(std::size_t pos) const {
+      std::uint32_t i = head;
+
+      while (pos-- > 0 && i != npos) {
+        i = slots[i].next;
+      }
 
+      return i;
+    }
+
+    std::uint32_t slotOf(const Handle& handle) const {
+      if (handle.slot >= slots.size()) return npos;
+
+      const Slot& slot = slots[handle.slot];
+      return slot.item && slot.generation == handle.generation ? handle.slot : npos;
+    }
+
+    template<typename T>
+    static void destroyAs(void* storage) {
+      static_cast<T*>(storage)->~T();
+    }
+
+  public:
+    /**
+      @brief Inserts the item at the position. Takes ownership of the item.
+      @warning Finding the position walks the list. Prefer inserting next to a Handle.
+    */
+    Handle insert(std::size_t pos, ActionItem* item) {
+      return place(slotAt(pos), item);
+    }
+
+    /**
+      @brief Inserts the item in front of the item the handle refers to. Takes ownership of the item.
+
+      If the handle is stale the item is added to the back.
+    */
+    Handle insert(const Handle& before, ActionItem* item) {
+      return place(slotOf(before), item);
+    }
+
+    /**
+      @brief Moves every item of the other list to the position. The other list is left empty.
+    */
     void insert(std::size_t pos, ActionList* other) {
       if (other == nullptr)
         throw std::runtime_error("ActionList is nullptr");
 
-      for (int i = 0; i < other->items.size(); i++) {
-        this->insert(pos + i, other->items[i]);
+      splice(slotAt(pos), *other);
+    }
+
+    /**
+      @brief Adds the item to the back of the list and takes ownership of it
+    */
+    Handle add(ActionItem* item) {
+      return place(npos, item);
+    }
+
+    /**
+      @brief Constructs the item in the list's arena and adds it to the back of the list
+
+      e.g. list.emplace<WaitAction>(sf::seconds(2));
+    */
+    template<typename T, typename... Args>
+    Handle emplace(Args&&... args) {
+      static_assert(std::is_base_of<ActionItem, T>::value, "T must derive from ActionItem");
+
+      if constexpr (!ActionArena::fits(sizeof(T), alignof(T))) {
+        return add(new T(std::forward<Args>(args)...));
       }
+      else {
+        if (!arena) {
+          arena = std::make_shared<ActionArena>();
+        }
 
-      other->items.clear();
+        void* storage = arena->allocate(sizeof(T));
+        T* item = nullptr;
+
+        try {
+          item = new (storage) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+          arena->deallocate(storage, sizeof(T));
+          throw;
+        }
+
+        return place(npos, item, storage, arena.get(), sizeof(T), &destroyAs<T>);
+      }
     }
 
-    void add(ActionItem* item) {
-      item->list = this;
-      items.push_back(item);
-      item->index = items.size() - 1;
+    /**
+      @brief Returns the item the handle refers to or nullptr if it was removed
+    */
+    ActionItem* find(const Handle& handle) const {
+      std::uint32_t index = slotOf(handle);
+      return index == npos ? nullptr : slots[index].item;
+    }
+
+    const bool contains(const Handle& handle) const {
+      return slotOf(handle) != npos;
     }
 
     const bool isEmpty() const {
-      return items.empty();
+      return head == npos;
+    }
+
+    const std::size_t size() const {
+      return count;
     }
 
     void clear() {
-      for (auto item : items) {
-        delete item;
+      while (head != npos) {
+        erase(head);
       }
-
-      items.clear();
     }
 
     void append(ActionList& list) {
-      for (int i = 0; i < list.items.size(); i++) {
-        items.push_back(list.items[i]);
-      }
-
-      list.items.clear();
+      splice(npos, list);
     }
 
     void append(ActionList* list) {
       if (list == nullptr)
         throw std::runtime_error("ActionList is nullptr");
 
-      for (int i = 0; i < list->items.size(); i++) {
-        items.push_back(list->items[i]);
-      }
-
-      list->items.clear();
-
+      splice(npos, *list);
     }
 
     void update(sf::Time elapsed) {
-      for (int i = 0; i < items.size();) {
-        if (items[i]->isDone()) {
-          delete items[i];
-          items.erase(items.begin() + i);
+      std::uint32_t i = head;
+
+      while (i != npos) {
+        ActionItem* item = slots[i].item;
+
+        if (item->isDone()) {
+          std::uint32_t next = slots[i].next;
+          erase(i);
+          i = next;
+          continue;
+        }
+
+        if (item->isThreadSafe && !item->isBlocking) {
+          i = updateRun(i, elapsed);
           continue;
         }
 
-        items[i]->index = (std::size_t) i;
-        items[i]->update(elapsed);
+        item->update(elapsed);
 
         if (clearFlag) {
           clearFlag = false;
-          i = 0;
+          i = head;
           continue; // startover, the list has been modified
         }
 
-        if (items[i]->isBlocking) {
+        if (item->isBlocking) {
           break;
         }
 
-        i++;
+        // read after the update in case items were inserted after this one
+        i = slots[i].next;
       }
     }
 
+    /**
+      @brief Runs of thread safe items shorter than this are updated on the calling thread
+      @param count. Default is 32. 0 or 1 sends every run to the worker pool.
+    */
+    void setParallelThreshold(std::size_t count) {
+      parallelThreshold = count;
+    }
+
+    const std::size_t getParallelThreshold() const {
+      return parallelThreshold;
+    }
+
+    /**
+      @brief Pool that updates thread safe runs. The pool must outlive the list.
+      @param pool. nullptr uses WorkerPool::shared()
+    */
+    void setWorkerPool(WorkerPool* pool) {
+      this->pool = pool;
+    }
+
     void draw(sf::RenderTexture& surface) {
-      for (auto item : items) {
+      for (std::uint32_t i = head; i != npos; i = slots[i].next) {
+        ActionItem* item = slots[i].item;
         item->draw(surface);
+
         if (item->isBlocking) {
           break;
         }
@@ -183,11 +587,24 @@ namespace swoosh {
 
     ActionList() { clearFlag = false; }
 
+    ActionList(const ActionList& rhs) = delete;
+    ActionList& operator=(const ActionList& rhs) = delete;
+
     ~ActionList() {
       clear();
     }
   };
 
+  inline const std::size_t ActionItem::getIndex() const {
+    std::size_t pos = 0;
+
+    for (std::uint32_t i = list ? list->head : ActionList::npos; i != ActionList::npos && i != slot; i = list->slots[i].next) {
+      pos++;
+    }
+
+    return pos;
+  }
+
   /**
   @class ClearPreviousActions
 
@@ -208,16 +625,8 @@ namespace swoosh {
       if (isDone())
         return;
 
-      for (int i = 0; i < list->items.size();) {
-        ActionItem* item = list->items[i];
-        if (item != this) {
-          delete item;
-          list->items.erase(list->items.begin() + i);
-          continue;
-        }
-        else {
-          break;
-        }
+      while (list->head != slot) {
+        list->erase(list->head);
       }
 
       list->clearFlag = true;
@@ -232,7 +641,7 @@ namespace swoosh {
   @class ClearAllActions
   @brief You may need to signal a cleanup in the action list to remove everything including non-blocking action items
 
-  ClearAllActions is suited for this task. 
+  ClearAllActions is suited for this task.
   */
 
   class ClearAllActions : public BlockingActionItem {
@@ -248,14 +657,14 @@ namespace swoosh {
         return;
 
       // Delete and remove everything but this one
-      for (int i = 0; i < list->items.size();) {
-        ActionItem* item = list->items[i];
-        if (item != this) {
-          delete item;
-          list->items.erase(list->items.begin() + i);
-          continue;
+      for (std::uint32_t i = list->head; i != ActionList::npos;) {
+        std::uint32_t next = list->slots[i].next;
+
+        if (i != slot) {
+          list->erase(i);
         }
-        i++;
+
+        i = next;
       }
 
       list->clearFlag = true;
@@ -268,9 +677,9 @@ namespace swoosh {
 
   /**
   @class ConditionalBranchListAction
-  
+
   @brief Situations may require to branch off into separate lists depending on the query function
-  
+
   ConditionalBranchListAction is similar to an if-else block where the outcome is to append different action items
 
   It takes a lambda function that returns bool and two ActionList pointers.
@@ -299,12 +708,13 @@ namespace swoosh {
       if (isDone())
         return;
 
+      // Spliced in front of this item so the branch runs next
       if (condition()) {
-        list->insert(getIndex(), branchIfTrue);
+        list->splice(slot, *branchIfTrue);
         branchIfFalse->clear();
       }
       else {
-        list->insert(getIndex(), branchIfFalse);
+        list->splice(slot, *branchIfFalse);
         branchIfTrue->clear();
       }
 
@@ -0,0 +1,184 @@
+#pragma once
+#include "ActionList.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace swoosh {
+  /**
+    @brief Steps used by ActionSequence
+
+    A step is any type with these members. No base class or virtual functions are needed.
+
+      void update(sf::Time elapsed);
+      void draw(sf::RenderTexture& surface);  // optional
+      bool isDone() const;
+
+    A step may declare `static constexpr bool threadSafe = true;` if update() only touches its own state.
+  */
+  namespace steps {
+    /**
+      @class Wait
+      @brief Finishes after `Milliseconds` have elapsed
+    */
+    template<long long Milliseconds>
+    class Wait {
+      sf::Int64 left{ Milliseconds * 1000 }; //!< microseconds
+
+    public:
+      static constexpr bool threadSafe = true;
+
+      void update(sf::Time elapsed) { left -= elapsed.asMicroseconds(); }
+      bool isDone() const { return left <= 0; }
+    };
+
+    /**
+      @class Invoke
+      @brief Calls the function once and finishes
+    */
+    template<typename Fn>
+    class Invoke {
+      Fn fn;
+      bool done{ false };
+
+    public:
+      explicit Invoke(Fn fn) : fn(std::move(fn)) { }
+
+      void update(sf::Time elapsed) {
+        fn();
+        done = true;
+      }
+
+      bool isDone() const { return done; }
+    };
+
+    /**
+      @class Until
+      @brief Finishes the first frame the condition returns true
+    */
+    template<typename Fn>
+    class Until {
+      Fn condition;
+      bool done{ false };
+
+    public:
+      explicit Until(Fn condition) : condition(std::move(condition)) { }
+
+      void update(sf::Time elapsed) { done = condition(); }
+      bool isDone() const { return done; }
+    };
+
+    namespace detail {
+      template<typename Step, typename = void>
+      struct HasDraw : std::false_type { };
+
+      template<typename Step>
+      struct HasDraw<Step, std::void_t<decltype(std::declval<Step&>().draw(std::declval<sf::RenderTexture&>()))>> : std::true_type { };
+
+      template<typename Step, typename = void>
+      struct IsThreadSafe : std::false_type { };
+
+      template<typename Step>
+      struct IsThreadSafe<Step, std::void_t<decltype(Step::threadSafe)>> : std::bool_constant<Step::threadSafe> { };
+
+      template<typename Step, typename = void>
+      struct IsStep : std::false_type { };
+
+      template<typename Step>
+      struct IsStep<Step, std::void_t<decltype(std::declval<Step&>().update(std::declval<sf::Time>())),
+                                      decltype(bool(std::declval<const Step&>().isDone()))>> : std::true_type { };
+    }
+  }
+
+  /**
+    @class ActionSequence
+    @brief Runs a fixed list of steps one after the other as a single ActionItem
+
+    The steps are stored inline in the sequence and picked by index, so stepping makes no virtual calls
+    and no allocations. The only virtual call is the one the ActionList makes into the sequence.
+
+    e.g. list.emplace<ActionSequence<steps::Wait<500>, MoveTo, FadeOut>>(steps::Wait<500>(), MoveTo(...), FadeOut(...));
+
+    A step that finishes hands over to the next step on the next update, the same as items in an ActionList.
+    The sequence is marked done after its last step finishes. It is thread safe if every step is.
+  */
+  template<typename... Steps>
+  class ActionSequence final : public ActionItem {
+    static_assert(sizeof...(Steps) > 0, "ActionSequence needs at least one step");
+    static_assert((steps::detail::IsStep<Steps>::value && ...), "Every step needs update(sf::Time) and isDone()");
+
+    std::tuple<Steps...> sequence;
+    std::size_t current{};
+
+    template<typename Fn, std::size_t... I>
+    void visit(Fn&& fn, std::index_sequence<I...>) {
+      // Expands to a chain of index compares the compiler can turn into a jump table
+      (void)((current == I ? (fn(std::get<I>(sequence)), true) : false) || ...);
+    }
+
+    template<typename Fn>
+    void visit(Fn&& fn) {
+      visit(std::forward<Fn>(fn), std::index_sequence_for<Steps...>());
+    }
+
+  public:
+    ActionSequence(Steps... args) : ActionItem(), sequence(std::move(args)...) {
+      isThreadSafe = (steps::detail::IsThreadSafe<Steps>::value && ...);
+    }
+
+    /**
+      @brief Default constructs every step e.g. ActionSequence<steps::Wait<500>, steps::Wait<200>>()
+    */
+    template<bool Defaultable = (std::is_default_constructible<Steps>::value && ...), std::enable_if_t<Defaultable, int> = 0>
+    ActionSequence() : ActionSequence(Steps()...) { }
+
+    /**
+      @brief Make the sequence block the action list until it finishes
+    */
+    ActionSequence& blocking(bool enabled = true) {
+      isBlocking = enabled;
+      return *this;
+    }
+
+    /**
+      @brief Query the index of the step that is running
+    */
+    const std::size_t getStep() const {
+      return current;
+    }
+
+    static constexpr std::size_t size() {
+      return sizeof...(Steps);
+    }
+
+    void update(sf::Time elapsed) override {
+      if (isDone()) return;
+
+      bool finished = false;
+
+      visit([&](auto& step) {
+        step.update(elapsed);
+        finished = step.isDone();
+      });
+
+      if (finished && ++current == sizeof...(Steps)) {
+        markDone();
+      }
+    }
+
+    void draw(sf::RenderTexture& surface) override {
+      if (isDone()) return;
+
+      visit([&](auto& step) {
+        if constexpr (steps::detail::HasDraw<std::decay_t<decltype(step)>>::value) {
+          step.draw(surface);
+        }
+      });
+    }
+  };
+
+  template<typename... Steps>
+  ActionSequence(Steps...) -> ActionSequence<Steps...>;
+}
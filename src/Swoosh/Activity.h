@@ -50,6 +50,20 @@ namespace swoosh {
     virtual void onUpdate(double elapsed) = 0;
     virtual void onDraw(sf::RenderTexture& surface) = 0;
     virtual ~Activity() { ; }
+
+    /**
+      @brief Override and return true if this activity looks the same every frame
+      
+      Segues will capture static activities once and reuse the result instead of redrawing them.
+    */
+    virtual bool isStatic() const { return false; }
+
+    /**
+      @brief Override and return false while this activity is still loading
+
+      A segue to a prefetched activity waits until it is ready. See: ActivityController::prefetch()
+    */
+    virtual bool isReady() const { return true; }
     void setView(const sf::View& view) { this->view = view; }
     void setView(const sf::Vector2u& size) { this->view = sf::View(sf::FloatRect(0.0f, 0.0f, (float)size.x, (float)size.y)); }
     void setView(const sf::FloatRect& rect) { this->view = sf::View(rect); }
@@ -3,11 +3,26 @@
 #include "Activity.h"
 #include "Segue.h"
 #include "Timer.h"
+#include "SurfacePool.h"
+#include "RenderScale.h"
+#include "QualityGovernor.h"
+#include "ActivityStack.h"
+#include "FrameStats.h"
+#include "ResourceCache.h"
+#include "ShaderCache.h"
+#include "MeshCache.h"
+#include "TimerService.h"
+#include "Task.h"
 #include <SFML/Graphics.hpp>
-#include <stack>
 #include <list>
+#include <cmath>
 #include <functional>
 #include <utility>
+#include <future>
+#include <chrono>
+#include <tuple>
+#include <typeindex>
+#include <unordered_map>
 #include <cstddef>
 
 namespace swoosh {
@@ -18,12 +33,40 @@ namespace swoosh {
 
   private:
     swoosh::Activity* last{ nullptr }; //!< Pointer of the last activity
-    std::stack<swoosh::Activity*> activities; //!< Stack of activities
+    ActivityStack activities; //!< Stack of owned activities indexed by type
     sf::RenderWindow& handle; //!< sfml window reference
     sf::Vector2u virtualWindowSize; //!< Window size requested to render with
     bool willLeave{}; //!< If true, the activity will leave
     bool useShaders{ true }; //!< If false, segues can considerately use shader effects
     mutable sf::RenderTexture* surface{ nullptr }; //!< Render surface to draw to
+    mutable sf::RenderTexture* lastSurface{ nullptr }; //!< Dedicated surface segues draw the last activity to
+    mutable sf::RenderTexture* nextSurface{ nullptr }; //!< Dedicated surface segues draw the next activity to
+    SurfacePool surfacePool; //!< Scratch surfaces leased out to multi-pass effects
+    SurfacePool::Lease scaledSurface; //!< Surface a scaled segue draws to before it is stretched over the render surface
+    SurfacePool::Lease scaledLastSurface; //!< Scaled capture of the last activity
+    SurfacePool::Lease scaledNextSurface; //!< Scaled capture of the next activity
+    RenderScale renderScale; //!< Resolution scaled segues are drawn at
+    QualityGovernor governor; //!< Picks the quality mode of each segue type from its frame time
+    std::size_t segueFrames{ 0 }; //!< Frames the segue on top has drawn
+    ResourceCache resources; //!< Media shared between activities
+    FrameProfiler profiler; //!< Frame phase timings per activity type
+    TimerService timers; //!< Tasks scheduled by activities on one shared timing wheel
+#ifdef SWOOSH_HAS_COROUTINES
+    TaskScheduler tasks{ timers }; //!< Coroutine tasks of every activity
+#endif
+
+    /**
+      @class Prefetch
+      @brief An activity constructed on a worker thread ahead of being pushed
+    */
+    struct Prefetch {
+      std::future<swoosh::Activity*> loading; //!< Valid until the constructor finishes
+      swoosh::Activity* activity{ nullptr }; //!< The constructed activity once loading is done
+    };
+
+    std::unordered_map<std::type_index, Prefetch> prefetches; //!< Prefetched activities by type
+    std::function<void()> deferredSegue; //!< Segue push waiting on a prefetched activity to be ready
+    std::type_index deferredType{ typeid(void) }; //!< Type of the prefetched activity the deferred segue waits on
 
     //!< Useful for state management and skipping need for dynamic casting
     enum class SegueAction : int {
@@ -33,6 +76,26 @@ namespace swoosh {
       none
     } segueAction;
 
+    SegueAction deferredAction{ SegueAction::none }; //!< Action the deferred segue becomes when it starts
+
+    /**
+      @class Blank
+      @brief Stand-in activity used to construct segues outside of a transition
+    */
+    class Blank : public Activity {
+    public:
+      Blank(ActivityController& ac) : Activity(&ac) { ; }
+      void onStart() override { }
+      void onLeave() override { }
+      void onExit() override { }
+      void onEnter() override { }
+      void onResume() override { }
+      void onEnd() override { }
+      void onUpdate(double) override { }
+      void onDraw(sf::RenderTexture&) override { }
+      bool isStatic() const override { return true; }
+    };
+
     //!< Useful for state management
     enum class StackAction : int {
       pop = 0,
@@ -43,6 +106,11 @@ namespace swoosh {
 
     quality qualityLevel{ quality::realtime }; //!< requested render quality
 
+    double fixedTimestep{ 0.0 }; //!< Seconds per simulation step. 0 uses the variable frame delta.
+    double accumulator{ 0.0 }; //!< Unsimulated time carried over to the next frame
+    double interpolation{ 1.0 }; //!< Fraction of a step left in the accumulator. Always 1 in variable mode.
+    unsigned int maxStepsPerFrame{ 5 }; //!< Clamps simulation steps per frame to avoid a spiral of death
+
   public:
     /**
       @brief constructs the activity controller, sets the virtual window size to the window, and initializes default values
@@ -52,6 +120,12 @@ namespace swoosh {
 
       surface = new sf::RenderTexture();
       surface->create((unsigned int)handle.getSize().x, (unsigned int)handle.getSize().y);
+
+      lastSurface = new sf::RenderTexture();
+      lastSurface->create((unsigned int)handle.getSize().x, (unsigned int)handle.getSize().y);
+
+      nextSurface = new sf::RenderTexture();
+      nextSurface->create((unsigned int)handle.getSize().x, (unsigned int)handle.getSize().y);
       willLeave = false;
       segueAction = SegueAction::none;
       stackAction = StackAction::none;
@@ -67,6 +141,12 @@ namespace swoosh {
 
       surface = new sf::RenderTexture();
       surface->create((unsigned int)virtualWindowSize.x, (unsigned int)virtualWindowSize.y);
+
+      lastSurface = new sf::RenderTexture();
+      lastSurface->create((unsigned int)virtualWindowSize.x, (unsigned int)virtualWindowSize.y);
+
+      nextSurface = new sf::RenderTexture();
+      nextSurface->create((unsigned int)virtualWindowSize.x, (unsigned int)virtualWindowSize.y);
       willLeave = false;
       segueAction = SegueAction::none;
       stackAction = StackAction::none;
@@ -78,19 +158,37 @@ namespace swoosh {
       @brief Deconstructor deletes all activities and surfaces cleanly
     */
     virtual ~ActivityController() {
-      if (segueAction != SegueAction::none) {
-        swoosh::Segue* effect = static_cast<swoosh::Segue*>(activities.top());
-        delete effect;
-        activities.pop();
+      // Wait for workers so no activity is left constructing
+      for (auto& [type, prefetch] : prefetches) {
+        if (prefetch.activity) {
+          delete prefetch.activity;
+        }
+        else if (prefetch.loading.valid()) {
+          // A constructor that threw has nothing to delete and must not throw out of here
+          try {
+            delete prefetch.loading.get();
+          }
+          catch (...) { }
+        }
       }
 
-      while (!activities.empty()) {
-        swoosh::Activity* activity = activities.top();
-        activities.pop();
-        delete activity;
-      }
+      prefetches.clear();
+
+#ifdef SWOOSH_HAS_COROUTINES
+      // Task frames may still refer to their activity
+      tasks.clear();
+#endif
+
+      // Top-down, so an active segue is deleted first
+      activities.truncate(0);
 
       delete surface;
+      delete lastSurface;
+      delete nextSurface;
+
+      // Free shared programs and meshes while the window's GL context is still alive
+      ShaderCache::clear();
+      MeshCache::clear();
     }
 
     /**
@@ -114,6 +212,159 @@ namespace swoosh {
       return surface;
     }
 
+    /**
+      @brief Returns the media cache shared by every activity on this controller
+
+      e.g. texture = getController().getResources().loadTexture(PATH);
+    */
+    ResourceCache& getResources() {
+      return resources;
+    }
+
+    /**
+      @brief Returns the timers shared by every activity on this controller
+
+      e.g. cooldown = getController().getTimers().after(this, sf::seconds(2), [this] { canFire = true; });
+
+      Tasks owned by an activity pause while it is not on top and are cancelled when it is deleted.
+      Schedule from the thread driving the controller e.g. in onStart() rather than in prefetched constructors.
+    */
+    TimerService& getTimers() {
+      return timers;
+    }
+
+#ifdef SWOOSH_HAS_COROUTINES
+    /**
+      @brief Returns the scheduler that runs coroutine tasks. Only available in C++20 builds.
+
+      e.g. getController().getTasks().start(this, intro());
+
+      Tasks owned by an activity run while it is on top and are destroyed when it is deleted.
+      See: swoosh::Task
+    */
+    TaskScheduler& getTasks() {
+      return tasks;
+    }
+#endif
+
+    /**
+      @brief Lease a scratch render surface from the controller's pool
+      @param size. The size of the surface in pixels
+      @param settings. Context settings for the surface. Surfaces are only reused for matching sizes and settings.
+      @return a lease that returns the surface to the pool when it goes out of scope
+
+      e.g. auto rt = getController().leaseSurface(getController().getVirtualWindowSize());
+    */
+    SurfacePool::Lease leaseSurface(const sf::Vector2u& size, const sf::ContextSettings& settings = sf::ContextSettings()) {
+      return surfacePool.lease(size, settings);
+    }
+
+    /**
+      @brief Returns the pool scratch surfaces are leased from e.g. for multi-pass shaders like glsl::DownsampledBlur
+    */
+    SurfacePool& getSurfacePool() {
+      return surfacePool;
+    }
+
+    /**
+      @brief Query the hits, misses, and bytes resident of the scratch surface pool
+    */
+    const SurfacePool::Stats& getSurfacePoolStats() const {
+      return surfacePool.getStats();
+    }
+
+    /**
+      @brief Frees every scratch surface that is not currently leased
+    */
+    void trimSurfacePool() {
+      surfacePool.trim();
+    }
+
+    /**
+      @brief Frames that take longer than this are counted as over budget in the frame stats
+      @param seconds. Default is 1/60.0
+    */
+    void setFrameBudget(double seconds) {
+      profiler.setBudget(seconds);
+    }
+
+    /**
+      @brief Query the frame budget in seconds
+    */
+    const double getFrameBudget() const {
+      return profiler.getBudget();
+    }
+
+    /**
+      @brief Sets the resolution segues are drawn at in a quality mode
+      @param mode. The quality mode the scale is used in
+      @param scale. Fraction of the virtual window size in (0, 1]. Default is 1 in every mode.
+
+      Only segues that enable render scaling are affected. See: Segue::enableRenderScale()
+      Their captures and effect passes run at the lower resolution and the result is stretched over the render surface in one draw.
+    */
+    void setRenderScale(quality mode, float scale) {
+      renderScale.set(mode, scale);
+    }
+
+    /**
+      @brief Query the render scale of a quality mode
+    */
+    const float getRenderScale(quality mode) const {
+      return renderScale.get(mode);
+    }
+
+    /**
+      @brief Lowers the render scale while segues take longer to draw than the frame budget and raises it again while they fit
+      @param enabled. Default is disabled
+      @param minimum. Lowest scale it may pick
+
+      The scale of the quality mode, or the segue's own scale, is the highest it may pick. See: setFrameBudget()
+    */
+    void enableAdaptiveRenderScale(bool enabled, float minimum = 0.5f) {
+      renderScale.setAdaptive(enabled, minimum);
+    }
+
+    /**
+      @brief Returns a quick check if the render scale follows the frame time
+    */
+    const bool isAdaptiveRenderScaleEnabled() const {
+      return renderScale.isAdaptive();
+    }
+
+    /**
+      @brief Query the scale the adaptive render scale settled on before it is capped and rounded
+    */
+    const float getAdaptiveRenderScale() const {
+      return renderScale.getAdaptive();
+    }
+
+    /**
+      @brief Query the timing of activity or segue type T
+      @return p50/p95/p99/max of the update, draw, and composite phases in milliseconds
+
+      Only the most recent samples are summarized. Segues are reported under their effect type.
+      Always empty when compiled with SWOOSH_FRAME_STATS 0.
+    */
+    template<typename T>
+    FrameStats getStats() const {
+      return profiler.summarize(std::type_index(typeid(T)));
+    }
+
+    /**
+      @brief Query the timing of every activity and segue type that has been on top of the stack
+    */
+    std::vector<FrameStats> getStats() const {
+      return profiler.summarize();
+    }
+
+    /**
+      @brief Clears all frame stats
+    */
+    void resetStats() {
+      profiler.reset();
+    }
+
     /**
       @brief Query the number of activities on the stack
     */
@@ -131,10 +382,10 @@ namespace swoosh {
 
     /**
       @brief Returns a quick check if the AC has been configured to use something other than realtime (default)
-      @return false if qualityLevel == quality::realtime (default)
+      @return false if the requested quality is quality::realtime (default)
     */
     const bool isOptimizedForPerformance() const {
-      return qualityLevel != quality::realtime;
+      return getRequestedQuality() != quality::realtime;
     }
 
     /**
@@ -157,9 +408,37 @@ namespace swoosh {
       @brief Query the requested quality mode
       
       This should be used by segue effects to provide alternative visuals for various-grade GPUs
+      While the quality governor is enabled, this is the mode it picked for the segue that is running.
+      It can change from one frame to the next so read it every frame instead of keeping it.
     */
     const quality getRequestedQuality() const {
-      return qualityLevel;
+      return governor.resolve(qualityLevel);
+    }
+
+    /**
+      @brief Lets the controller lower the quality mode of segue types that take longer to draw than the frame budget
+      @param enabled. Default is disabled
+
+      The mode set by optimizeForPerformance() is the best mode it picks. See: QualityGovernor, setFrameBudget()
+    */
+    void enableQualityGovernor(bool enabled) {
+      governor.enable(enabled);
+    }
+
+    /**
+      @brief Returns a quick check if the quality governor is enabled
+    */
+    const bool isQualityGovernorEnabled() const {
+      return governor.isEnabled();
+    }
+
+    /**
+      @brief Returns the quality governor to tune its thresholds, listen for changes, or read its decisions
+
+      e.g. getQualityGovernor().onChange([](const QualityChange& change) { log(change.name, change.frameTime); });
+    */
+    QualityGovernor& getQualityGovernor() {
+      return governor;
     }
 
     /**
@@ -175,12 +454,10 @@ namespace swoosh {
         e.g. queuePop<segue<FadeOut>>(); // will transition from the current scene to the last with a fadeout effect
       */
       void delegateActivityPop(ActivityController& owner) {
-        swoosh::Activity* last = owner.activities.top();
-        owner.activities.pop();
-
-        swoosh::Activity* next = owner.activities.top();
-        owner.activities.pop();
+        swoosh::Activity* last = owner.activities.pop().release();
+        swoosh::Activity* next = owner.activities.pop().release();
 
+        owner.governor.begin(typeid(T));
         swoosh::Segue* effect = new T(DurationType::value(), last, next);
         sf::Vector2u windowSize = owner.getVirtualWindowSize();
         sf::View view(sf::FloatRect(0, 0, (float)windowSize.x, (float)windowSize.y));
@@ -188,6 +465,8 @@ namespace swoosh {
 
         effect->setActivityViewFunc = &ActivityController::setActivityView;
         effect->resetViewFunc = &ActivityController::resetView;
+        effect->lastSurface = owner.lastSurface;
+        effect->nextSurface = owner.nextSurface;
         effect->onStart();
         effect->started = true;
         owner.activities.push(effect);
@@ -202,6 +481,7 @@ namespace swoosh {
       template<typename U>
       class to {
       public:
+        using activity_type = U; //!< The activity this segue transitions to
 
         to() { ; }
 
@@ -210,10 +490,23 @@ namespace swoosh {
         */
         template<typename... Args >
         void delegateActivityPush(ActivityController& owner, Args&&... args) {
+          swoosh::Activity* next = owner.takePrefetch(typeid(U));
+
+          if (!next) {
+            next = new U(owner, std::forward<Args>(args)...);
+          }
+
+          delegateActivityStart(owner, next);
+        }
+
+        /**
+          @brief Starts the PUSH segue to an already constructed activity
+        */
+        void delegateActivityStart(ActivityController& owner, swoosh::Activity* next) {
           bool hasLast = (owner.activities.size() > 0);
           swoosh::Activity* last = hasLast ? owner.activities.top() : owner.generateActivityFromWindow();
-          swoosh::Activity* next = new U(owner, std::forward<Args>(args)...);
 
+          owner.governor.begin(typeid(T));
           swoosh::Segue* effect = new T(DurationType::value(), last, next);
           sf::Vector2u windowSize = owner.getVirtualWindowSize();
           sf::View view(sf::FloatRect(0.f, 0.f, (float)windowSize.x, (float)windowSize.y));
@@ -221,6 +514,8 @@ namespace swoosh {
 
           effect->setActivityViewFunc = &ActivityController::setActivityView;
           effect->resetViewFunc = &ActivityController::resetView;
+          effect->lastSurface = owner.lastSurface;
+          effect->nextSurface = owner.nextSurface;
 
           effect->onStart();
           effect->started = true;
@@ -229,54 +524,40 @@ namespace swoosh {
 
         /**
           @brief This will start a REWIND state for the activity controller and creates a segue object onto the stack
-          @return True if the target activity type T is found in the stack, false otherwise. Found activities transform into segues.
+          @return True if the target activity type U is found in the stack, false otherwise. Found activities transform into segues.
 
-          This must use dynamic casting to find the target type T* in the activity stack.
-          If no activity is found, all the activities are carefully placed back into the stack.
-          If the target ativity is found, the traverse activities are deleted.
+          The target type U is found in constant time using the activity stack's type index.
+          The top activity is the one leaving so only the activities below it are searched.
+          If no activity is found, the stack is left untouched.
+          If the target ativity is found, the traversed activities are ended and deleted.
         */
         template<typename... Args >
         bool delegateActivityRewind(ActivityController& owner, Args&&... args) {
-          std::stack<swoosh::Activity*> original;
-
           bool hasMore = (owner.activities.size() > 1);
 
           if (!hasMore) { return false; }
 
-          swoosh::Activity* last = owner.activities.top();
-          owner.activities.pop();
-
-          swoosh::Activity* next = owner.activities.top();
-
-          while (dynamic_cast<T*>(next) == 0 && owner.activities.size() > 1) {
-            original.push(next);
-            owner.activities.pop();
-            next = owner.activities.top();
-          }
-
-          if (owner.activities.empty()) {
-            // We did not find it, push the states back on the list and return false
-            while (original.size() > 0) {
-              owner.activities.push(original.top());
-              original.pop();
-            }
-
-            owner.activities.push(last);
+          // The top activity is leaving so search below it
+          std::size_t pos = owner.activities.findBelow<U>(owner.activities.size() - 1);
 
+          if (pos == ActivityStack::npos) {
             return false;
           }
 
+          swoosh::Activity* last = owner.activities.pop().release();
+
           // We did find it, call on end to everything and free memory
-          while (original.size() > 0) {
-            swoosh::Activity* top = original.top();
-            top->onEnd();
-            delete top;
-            original.pop();
+          for (std::size_t i = pos + 1; i < owner.activities.size(); i++) {
+            owner.activities.at(i)->onEnd();
+            owner.releaseTasks(owner.activities.at(i));
           }
 
+          owner.activities.truncate(pos + 1);
+
           // Remove next from the activity stack
-          owner.activities.pop();
+          swoosh::Activity* next = owner.activities.pop().release();
 
+          owner.governor.begin(typeid(T));
           swoosh::Segue* effect = new T(DurationType::value(), last, next);
           sf::Vector2u windowSize = owner.getVirtualWindowSize();
           sf::View view(sf::FloatRect(0.0f, 0.0f, (float)windowSize.x, (float)windowSize.y));
@@ -284,6 +565,8 @@ namespace swoosh {
           
           effect->setActivityViewFunc = &ActivityController::setActivityView;
           effect->resetViewFunc = &ActivityController::resetView;
+          effect->lastSurface = owner.lastSurface;
+          effect->nextSurface = owner.nextSurface;
 
           effect->onStart();
           effect->started = true;
@@ -327,7 +610,21 @@ namespace swoosh {
     {
       template<typename... Args >
       ResolvePushSegueIntent(ActivityController& owner, Args&&... args) {
-        if (owner.segueAction == SegueAction::none) {
+        if (owner.segueAction == SegueAction::none && !owner.deferredSegue) {
+          std::type_index type(typeid(typename T::activity_type));
+
+          if (owner.prefetches.count(type) && !owner.pollPrefetch(type)) {
+            // The current activity keeps running until the prefetched one is ready. See: update()
+            owner.deferredType = type;
+            owner.deferredAction = SegueAction::push;
+            owner.deferredSegue = [&owner]() {
+              T segueResolve;
+              segueResolve.delegateActivityStart(owner, owner.takePrefetch(owner.deferredType));
+            };
+
+            return;
+          }
+
           owner.segueAction = SegueAction::push;
           T segueResolve;
           segueResolve.delegateActivityPush(owner, std::forward<Args>(args)...);
@@ -344,9 +641,13 @@ namespace swoosh {
     {
       template<typename... Args>
       ResolvePushSegueIntent(ActivityController& owner, Args&&... args) {
-        if (owner.segueAction != SegueAction::none) return;
+        if (owner.segueAction != SegueAction::none || owner.deferredSegue) return;
+
+        swoosh::Activity* next = owner.takePrefetch(typeid(T));
 
-        swoosh::Activity* next = new T(owner, std::forward<Args>(args)...);
+        if (!next) {
+          next = new T(owner, std::forward<Args>(args)...);
+        }
 
         if (owner.last == nullptr && owner.activities.size() != 0) {
           owner.last = owner.activities.top();
@@ -370,6 +671,7 @@ namespace swoosh {
     */
     template<typename T, typename... Args>
     void replace(Args&&... args) {
+      bool wasDeferred = static_cast<bool>(deferredSegue);
       size_t before = this->activities.size();
       ResolvePushSegueIntent<T, IsSegueType<T>::value> intent(*this, std::forward<Args>(args)...);
       size_t after = this->activities.size();
@@ -386,6 +688,54 @@ namespace swoosh {
           stackAction = StackAction::replace;
         }
       }
+      else if (!wasDeferred && deferredSegue) {
+        deferredAction = SegueAction::replace;
+      }
+    }
+
+    /**
+      @brief Constructs an activity on a worker thread so a later push does not hitch
+      @param args. Forwarded to the constructor of T. Arguments passed by reference must outlive the prefetch.
+      @return false if T is already prefetched
+
+      The next push<T>() or push<segue<Effect>::to<T>>() uses the prefetched activity and ignores its own arguments.
+      A segue push waits for the constructor to finish and for Activity::isReady() to be true before it begins.
+      Until then the current activity keeps updating and drawing.
+
+      @warning T's constructor runs on another thread. It must not modify the activity controller.
+    */
+    template<typename T, typename... Args>
+    bool prefetch(Args&&... args) {
+      std::type_index type(typeid(T));
+
+      if (prefetches.count(type)) return false;
+
+      std::tuple<Args...> params(std::forward<Args>(args)...);
+
+      prefetches[type].loading = std::async(std::launch::async, [this, params = std::move(params)]() mutable -> swoosh::Activity* {
+        return std::apply([this](auto&&... args) -> swoosh::Activity* {
+          return new T(*this, std::forward<decltype(args)>(args)...);
+        }, std::move(params));
+      });
+
+      return true;
+    }
+
+    /**
+      @brief Query if a prefetched activity of type T is waiting to be pushed
+    */
+    template<typename T>
+    const bool isPrefetched() const {
+      return prefetches.count(std::type_index(typeid(T))) > 0;
+    }
+
+    /**
+      @brief Query if a prefetched activity of type T is constructed and reports ready
+      @return false if T was never prefetched
+    */
+    template<typename T>
+    const bool isPrefetchReady() {
+      return pollPrefetch(std::type_index(typeid(T)));
     }
 
     /**
@@ -396,7 +746,7 @@ namespace swoosh {
     const bool pop() {
       // Have to have more than 1 on the stack to have a transition effect...
       bool hasLast = (activities.size() > 1);
-      if (!hasLast || segueAction != SegueAction::none) return false;
+      if (!hasLast || segueAction != SegueAction::none || deferredSegue) return false;
 
       segueAction = SegueAction::pop;
       T segueResolve;
@@ -412,7 +762,7 @@ namespace swoosh {
     const bool pop() {
       bool hasMore = (activities.size() > 0);
 
-      if (!hasMore || segueAction != SegueAction::none) return false;
+      if (!hasMore || segueAction != SegueAction::none || deferredSegue) return false;
 
       willLeave = true;
 
@@ -430,7 +780,7 @@ namespace swoosh {
       ResolveRewindSegueIntent(ActivityController& owner) {
       }
 
-      bool RewindSuccessful;
+      bool RewindSuccessful{ false };
     };
 
     /**
@@ -440,7 +790,7 @@ namespace swoosh {
     template<typename T>
     struct ResolveRewindSegueIntent<T, true>
     {
-      bool RewindSuccessful;
+      bool RewindSuccessful{ false };
 
       template<typename... Args >
       ResolveRewindSegueIntent(ActivityController& owner, Args&&... args) {
@@ -448,6 +798,10 @@ namespace swoosh {
           owner.segueAction = SegueAction::pop;
           T segueResolve;
           RewindSuccessful = segueResolve.delegateActivityRewind(owner, std::forward<Args>(args)...);
+
+          if (!RewindSuccessful) {
+            owner.segueAction = SegueAction::none;
+          }
         }
       }
     };
@@ -456,41 +810,30 @@ namespace swoosh {
     @class ResolveRewindSegueIntent<T, false>
     @brief If type is not a segue, looks for the matching activity. If it is not found, it does not rewind to that activity.
 
-    If a rewind is successful, all spanned activities are deleted.
+    If a rewind is successful, all spanned activities are ended and deleted.
+    Like a segue rewind, only the activities below the top are searched.
   */
     template<typename T>
     struct ResolveRewindSegueIntent<T, false>
     {
-      bool RewindSuccessful;
+      bool RewindSuccessful{ false };
 
       template<typename... Args>
       ResolveRewindSegueIntent(ActivityController& owner, Args&&... args) {
-        std::stack<swoosh::Activity*> original;
-
-        bool hasLast = (owner.activities.size() > 0);
-
-        if (!hasLast) { RewindSuccessful = false; return; }
+        std::size_t pos = owner.activities.findBelow<T>(owner.activities.size() - 1);
 
-        swoosh::Activity* next = owner.activities.top();
+        if (pos == ActivityStack::npos) { return; }
 
-        while (dynamic_cast<T*>(next) == 0 && owner.activities.size() > 1) {
-          original.push(next);
-          owner.activities.pop();
-          next = owner.activities.top();
+        // End spanned activities from the top down as if each were popped
+        for (std::size_t i = owner.activities.size(); i-- > pos + 1;) {
+          owner.activities.at(i)->onEnd();
+          owner.releaseTasks(owner.activities.at(i));
         }
 
-        if (owner.activities.empty()) {
-          // We did not find it, push the states back on the list and return false
-          while (original.size() > 0) {
-            owner.activities.push(original.top());
-            original.pop();
-          }
-
-          RewindSuccessful = false;
-          return;
-        }
+        owner.activities.truncate(pos + 1);
+        owner.activities.top()->onResume();
 
-        next->onResume();
+        RewindSuccessful = true;
       }
     };
 
@@ -500,12 +843,88 @@ namespace swoosh {
     */
     template<typename T, typename... Args>
     bool rewind(Args&&... args) {
-      if (this->activities.size() <= 1) return false;
+      if (this->activities.size() <= 1 || deferredSegue) return false;
 
       ResolveRewindSegueIntent<T, IsSegueType<T>::value> intent(*this, std::forward<Args>(args)...);
       return intent.RewindSuccessful;
     }
 
+    /**
+      @brief Query if an activity of type T is on the stack
+      @return true if found. Found in constant time after the first lookup of T.
+
+      Activities that are in the middle of a segue are not on the stack until the segue ends.
+    */
+    template<typename T>
+    bool contains() const {
+      return activities.find<T>() != ActivityStack::npos;
+    }
+
+    /**
+      @brief Finds the topmost activity of type T on the stack
+      @return pointer to the activity or nullptr if not found. Found in constant time after the first lookup of T.
+
+      Activities that are in the middle of a segue are not on the stack until the segue ends.
+    */
+    template<typename T>
+    T* find() const {
+      std::size_t pos = activities.find<T>();
+
+      if (pos == ActivityStack::npos) return nullptr;
+
+      return dynamic_cast<T*>(activities.at(pos));
+    }
+
+    /**
+      @brief Simulate activities and segues in fixed increments instead of the variable frame delta
+      @param seconds. The length of one simulation step e.g. 1/120.0. Zero or less disables fixed steps.
+      @param maxSteps. The most steps simulated in one update(). Time beyond that is dropped.
+
+      update() accumulates the frame delta and calls onUpdate() once per whole step.
+      The leftover fraction is available through getInterpolation() to blend state in onDraw().
+    */
+    void setFixedTimestep(double seconds, unsigned int maxSteps = 5) {
+      fixedTimestep = seconds > 0.0 ? seconds : 0.0;
+      maxStepsPerFrame = maxSteps > 0 ? maxSteps : 1;
+      accumulator = 0.0;
+      interpolation = 1.0;
+    }
+
+    /**
+      @brief Query the fixed simulation step in seconds
+      @return 0 if the variable frame delta is used (default)
+    */
+    const double getFixedTimestep() const {
+      return fixedTimestep;
+    }
+
+    /**
+      @brief Query how far the simulation is between the previous and the next step
+      @return value in [0, 1). Always 1 when not using a fixed timestep.
+
+      Activities should draw previous + (current - previous) * alpha to render smoothly between steps
+    */
+    const double getInterpolation() const {
+      return interpolation;
+    }
+
+    /**
+      @brief Compiles the shaders of every segue type ahead of time so their first transition does not hitch
+      @param Segues. The segue effect types to warm up e.g. precompile<BlurFadeIn, Cube3D<direction::left>>()
+
+      Each segue is constructed once with blank activities and drawn a single frame offscreen.
+      Its programs stay in the ShaderCache and are shared by every later instance.
+      Call this at boot or behind a loading screen. Uses the current quality mode and shader settings.
+      Does nothing while a segue is running because the segue surfaces are in use.
+    */
+    template<typename... Segues>
+    void precompile() {
+      if (segueAction != SegueAction::none) return;
+
+      Blank last(*this), next(*this);
+      (precompileSegue<Segues>(last, next), ...);
+    }
+
     /**
       @brief Returns the current activity pointer. Nullptr if no acitivty exists on the stack.
     */
@@ -518,59 +937,40 @@ namespace swoosh {
      @brief Updates the current activity or segue. Will manage the segue transition states.
      @param elapsed. Time in seconds
 
+     If a fixed timestep is set, the activities are stepped zero or more times with the fixed step instead.
+     See: setFixedTimestep()
+
      If optimized for performance and the quality mode is set to `mobile`, will not update the 
      activities in the segue to help increase performance on lower end hardware
     */
     void update(double elapsed) {
-      if (activities.size() == 0)
-        return;
+      startDeferredSegue();
 
-      if (willLeave) {
-        executePop();
-        willLeave = false;
-      }
-
-      if (activities.size() == 0)
+      if (fixedTimestep <= 0.0) {
+        step(elapsed);
         return;
+      }
 
-      if (stackAction == StackAction::push || stackAction == StackAction::replace) {
-        if (activities.size() > 1 && last) {
-          last->onExit();
-
-          if (stackAction == StackAction::replace) {
-            auto top = activities.top();
-            activities.pop(); // top
-            activities.pop(); // last, to be replaced by top
-            activities.push(top); // fin
-            delete last;
-          }
+      accumulator += elapsed;
 
-          last = nullptr;
-        }
+      unsigned int steps = 0;
 
-        activities.top()->onStart();
-        activities.top()->started = true;
-
-        stackAction = StackAction::none;
+      while (accumulator >= fixedTimestep && steps < maxStepsPerFrame) {
+        step(fixedTimestep);
+        accumulator -= fixedTimestep;
+        steps++;
       }
 
-      if (segueAction != SegueAction::none) {
-        swoosh::Segue* segue = static_cast<swoosh::Segue*>(activities.top());
-
-        if (getRequestedQuality() == quality::mobile) {
-          segue->timer.update(sf::seconds(static_cast<float>(elapsed)));
-        }
-        else {
-          segue->onUpdate(elapsed);
-        }
-
-        if (segue->timer.getElapsed().asMilliseconds() >= segue->duration.asMilliseconds()) {
-          endSegue(segue);
-        }
+      if (steps == 0) {
+        // Stack changes still need to happen before the next draw
+        applyPendingActions();
       }
-      else {
-        activities.top()->onUpdate(elapsed);
+      else if (accumulator >= fixedTimestep) {
+        // Too far behind. Drop the backlog and keep the fraction of a step.
+        accumulator = std::fmod(accumulator, fixedTimestep);
       }
+
+      interpolation = accumulator / fixedTimestep;
     }
 
     /**
@@ -580,22 +980,31 @@ namespace swoosh {
       if (activities.size() == 0)
         return;
 
-      surface->setView(activities.top()->view);
-      activities.top()->onDraw(*surface);
+      swoosh::Activity* top = activities.top();
 
-      surface->display();
+      {
+        auto sample = profiler.measure(*top, phase::draw);
+        drawTop(*surface, top);
+      }
 
-      // Capture buffer in a drawable context
-      sf::Sprite post(surface->getTexture());
+      {
+        auto sample = profiler.measure(*top, phase::composite);
+        surface->display();
 
-      // Fill in the bg color
-      handle.clear(activities.top()->bgColor);
+        // Capture buffer in a drawable context
+        sf::Sprite post(surface->getTexture());
 
-      // drawbuffer on top of the scene
-      handle.draw(post);
+        // Fill in the bg color
+        handle.clear(top->bgColor);
 
-      // Prepare buffer for next cycle
-      surface->clear(sf::Color::Transparent);
+        // drawbuffer on top of the scene
+        handle.draw(post);
+
+        // Prepare buffer for next cycle
+        surface->clear(sf::Color::Transparent);
+      }
+
+      profiler.endFrame(*top);
     }
 
     /**
@@ -606,15 +1015,144 @@ namespace swoosh {
       if (activities.size() == 0)
         return;
 
-      external.setView(activities.top()->view);
+      swoosh::Activity* top = activities.top();
 
-      // Fill in the bg color
-      handle.clear(activities.top()->bgColor);
+      {
+        auto sample = profiler.measure(*top, phase::draw);
+
+        // Fill in the bg color
+        handle.clear(top->bgColor);
+
+        drawTop(external, top);
+      }
 
-      activities.top()->onDraw(external);
+      profiler.endFrame(*top);
     }
 
   private:
+    /**
+      @brief Draws the activity on top into the target
+
+      Segues that enable render scaling are drawn into a smaller surface with smaller captures
+      and the result is stretched over the target.
+    */
+    void drawTop(sf::RenderTexture& target, swoosh::Activity* top) {
+      if (segueAction == SegueAction::none) {
+        target.setView(top->view);
+        top->onDraw(target);
+        return;
+      }
+
+      swoosh::Segue* segue = static_cast<swoosh::Segue*>(top);
+
+      auto start = std::chrono::steady_clock::now();
+      drawSegue(target, *segue);
+      std::chrono::duration<double> drawTime = std::chrono::steady_clock::now() - start;
+
+      // The first frame captures both scenes and is the first use of the segue's programs.
+      // It says nothing about the frames after it.
+      if (segueFrames++ == 0) return;
+
+      // Only what the segue costs to draw, so waiting on vsync or the app's own work does not count.
+      // Either may switch for the next frame.
+      governor.sample(drawTime.count(), profiler.getBudget(), qualityLevel);
+
+      if (segue->scalable) {
+        renderScale.sample(drawTime.count(), profiler.getBudget(), scaleCeiling(*segue));
+      }
+    }
+
+    /**
+      @brief Highest scale the segue may be drawn at
+    */
+    float scaleCeiling(const swoosh::Segue& segue) const {
+      return segue.renderScale > 0.0f ? RenderScale::clamp(segue.renderScale) : renderScale.get(getRequestedQuality());
+    }
+
+    /**
+      @brief Draws the segue into the target, at a lower resolution if it enables render scaling
+    */
+    void drawSegue(sf::RenderTexture& target, swoosh::Segue& segue) {
+      if (!segue.scalable) {
+        target.setView(segue.view);
+        segue.onDraw(target);
+        return;
+      }
+
+      float scale = renderScale.resolve(scaleCeiling(segue));
+      sf::Vector2u size(
+        std::max(1u, static_cast<unsigned int>(std::lround(virtualWindowSize.x * scale))),
+        std::max(1u, static_cast<unsigned int>(std::lround(virtualWindowSize.y * scale)))
+      );
+
+      if (scale < 1.0f && (!scaledSurface || scaledSurface->getSize() != size)) {
+        scaledSurface = surfacePool.lease(size);
+        scaledLastSurface = surfacePool.lease(size);
+        scaledNextSurface = surfacePool.lease(size);
+
+        if (!scaledSurface || !scaledLastSurface || !scaledNextSurface) {
+          releaseScaledSurfaces();
+          scale = 1.0f;
+        }
+      }
+
+      if (scale >= 1.0f) {
+        useCaptureSurfaces(segue, lastSurface, nextSurface, 1.0f);
+        target.setView(segue.view);
+        segue.onDraw(target);
+        return;
+      }
+
+      useCaptureSurfaces(segue, scaledLastSurface.get(), scaledNextSurface.get(), scale);
+
+      sf::RenderTexture& scaled = *scaledSurface;
+      scaled.setView(scaled.getDefaultView());
+      scaled.clear(sf::Color::Transparent);
+      segue.onDraw(scaled);
+      scaled.display();
+      scaled.setSmooth(true);
+
+      sf::Sprite sprite(scaled.getTexture());
+      sprite.setScale((float)virtualWindowSize.x / size.x, (float)virtualWindowSize.y / size.y);
+
+      target.setView(segue.view);
+      target.draw(sprite, sf::RenderStates(sf::BlendNone));
+    }
+
+    /**
+      @brief Points the segue's captures at the surfaces. Captures made at another scale are redrawn.
+    */
+    void useCaptureSurfaces(swoosh::Segue& segue, sf::RenderTexture* last, sf::RenderTexture* next, float scale) {
+      if (segue.lastSurface != last || segue.nextSurface != next) {
+        segue.lastSurface = last;
+        segue.nextSurface = next;
+        segue.lastCaptured = false;
+        segue.nextCaptured = false;
+      }
+
+      segue.appliedScale = scale;
+    }
+
+    /**
+      @brief Gives the scaled surfaces back to the pool
+    */
+    void releaseScaledSurfaces() {
+      scaledSurface.release();
+      scaledLastSurface.release();
+      scaledNextSurface.release();
+    }
+
+    /**
+      @brief Cancels the timers and destroys the coroutine tasks of an activity that is about to be deleted
+    */
+    void releaseTasks(const swoosh::Activity* activity) {
+      timers.release(activity);
+
+#ifdef SWOOSH_HAS_COROUTINES
+      tasks.release(activity);
+#endif
+    }
+
     /**
       @brief Applies an activity's view onto the render surface. This is used internally for segues.
 
@@ -633,12 +1171,187 @@ namespace swoosh {
       surface.setView(handle.getDefaultView());
     }
 
+    /**
+      @brief Constructs and draws one frame of a segue so its shaders are compiled and bound once
+    */
+    template<typename T>
+    void precompileSegue(Blank& last, Blank& next) {
+      T effect(sf::seconds(1), &last, &next);
+      swoosh::Segue& segue = effect;
+
+      sf::Vector2u windowSize = getVirtualWindowSize();
+      segue.setView(sf::View(sf::FloatRect(0.0f, 0.0f, (float)windowSize.x, (float)windowSize.y)));
+      segue.setActivityViewFunc = &ActivityController::setActivityView;
+      segue.resetViewFunc = &ActivityController::resetView;
+      segue.lastSurface = lastSurface;
+      segue.nextSurface = nextSurface;
+
+      // Drivers may defer work until a program is first used, so draw with it once
+      segue.onDraw(*surface);
+      surface->clear(sf::Color::Transparent);
+    }
+
+    /**
+      @brief Checks if a prefetched activity finished constructing and reports ready
+      @return false if the type was never prefetched or is still loading
+    */
+    bool pollPrefetch(const std::type_index& type) {
+      auto iter = prefetches.find(type);
+
+      if (iter == prefetches.end()) return false;
+
+      Prefetch& prefetch = iter->second;
+
+      if (!prefetch.activity) {
+        if (prefetch.loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+          return false;
+        }
+
+        prefetch.activity = finishPrefetch(iter);
+      }
+
+      return prefetch.activity->isReady();
+    }
+
+    /**
+      @brief Hands over a prefetched activity. Blocks if it is still constructing.
+      @return nullptr if the type was never prefetched
+    */
+    swoosh::Activity* takePrefetch(const std::type_index& type) {
+      auto iter = prefetches.find(type);
+
+      if (iter == prefetches.end()) return nullptr;
+
+      swoosh::Activity* activity = iter->second.activity;
+
+      if (!activity) {
+        activity = finishPrefetch(iter);
+      }
+
+      prefetches.erase(iter);
+      return activity;
+    }
+
+    /**
+      @brief Waits for a prefetched constructor to finish and returns the activity
+      @throws whatever the constructor threw. The prefetch and any segue push deferred on it are dropped first
+      so later pushes of the type construct it again instead of waiting on a dead prefetch.
+    */
+    swoosh::Activity* finishPrefetch(std::unordered_map<std::type_index, Prefetch>::iterator iter) {
+      try {
+        return iter->second.loading.get();
+      }
+      catch (...) {
+        if (deferredSegue && deferredType == iter->first) {
+          deferredSegue = nullptr;
+          deferredAction = SegueAction::none;
+        }
+
+        prefetches.erase(iter);
+        throw;
+      }
+    }
+
+    /**
+      @brief Begins a segue push that was waiting on its prefetched activity once the activity is ready
+    */
+    void startDeferredSegue() {
+      if (!deferredSegue || !pollPrefetch(deferredType)) return;
+
+      std::function<void()> start = std::move(deferredSegue);
+      deferredSegue = nullptr;
+
+      segueAction = SegueAction::push;
+      start();
+      segueAction = deferredAction;
+    }
+
+    /**
+      @brief Resolves deferred pops, pushes, and replaces on the activity stack
+      @return false if there are no activities left to update
+    */
+    bool applyPendingActions() {
+      if (activities.size() == 0)
+        return false;
+
+      if (willLeave) {
+        executePop();
+        willLeave = false;
+      }
+
+      if (activities.size() == 0)
+        return false;
+
+      if (stackAction == StackAction::push || stackAction == StackAction::replace) {
+        if (activities.size() > 1 && last) {
+          last->onExit();
+
+          if (stackAction == StackAction::replace) {
+            releaseTasks(last);
+            auto top = activities.pop(); // top
+            activities.pop(); // last, to be replaced by top. Deleted here.
+            activities.push(std::move(top)); // fin
+          }
+
+          last = nullptr;
+        }
+
+        activities.top()->onStart();
+        activities.top()->started = true;
+
+        stackAction = StackAction::none;
+      }
+
+      return true;
+    }
+
+    /**
+      @brief Advances the current activity or segue by `elapsed` seconds once
+    */
+    void step(double elapsed) {
+      if (!applyPendingActions())
+        return;
+
+#ifdef SWOOSH_HAS_COROUTINES
+      // Before the timers so a task woken by wait() that awaits nextFrame() runs next step
+      tasks.focus(activities.top());
+      tasks.update();
+#endif
+
+      // Only the activity on top counts down its timers
+      timers.focus(activities.top());
+      timers.update(elapsed);
+
+      if (segueAction != SegueAction::none) {
+        swoosh::Segue* segue = static_cast<swoosh::Segue*>(activities.top());
+
+        {
+          auto sample = profiler.measure(*segue, phase::update);
+
+          if (getRequestedQuality() == quality::mobile) {
+            segue->timer.update(sf::microseconds(static_cast<sf::Int64>(std::llround(elapsed * 1000000.0))));
+          }
+          else {
+            segue->onUpdate(elapsed);
+          }
+        }
+
+        if (segue->timer.getElapsed() >= segue->duration) {
+          endSegue(segue);
+        }
+      }
+      else {
+        auto sample = profiler.measure(*activities.top(), phase::update);
+        activities.top()->onUpdate(elapsed);
+      }
+    }
+
     /**
      @brief This function properly terminates an active segue and pushes the next activity onto the stack
    */
     void endSegue(swoosh::Segue* segue) {
       segue->onEnd();
-      activities.pop();
+      activities.pop().release(); // deleted below
 
       swoosh::Activity* next = segue->next;
 
@@ -658,9 +1371,10 @@ namespace swoosh {
         }
 
         if (segueAction == SegueAction::replace) {
-          activities.pop(); // remove last
+          activities.pop().release(); // remove last, deleted below
         }
 
+        releaseTasks(last);
         delete last;
       }
       else if (segueAction == SegueAction::push) {
@@ -668,23 +1382,29 @@ namespace swoosh {
         next->started = true;
       }
 
+      releaseTasks(segue);
       delete segue;
       activities.push(next);
       segueAction = SegueAction::none;
+      releaseScaledSurfaces();
+      governor.end();
+      segueFrames = 0;
+
+#ifdef SWOOSH_HAS_COROUTINES
+      tasks.segueFinished();
+#endif
     }
 
     /**
        @brief When pop() is invoked, the pop is not executed immediately. It is deffered until it is safe to pop the activity off the stack.
      */
     void executePop() {
-      swoosh::Activity* activity = activities.top();
-      activity->onEnd();
-      activities.pop();
+      activities.top()->onEnd();
+      std::unique_ptr<swoosh::Activity> activity = activities.pop();
+      releaseTasks(activity.get());
 
       if (activities.size() > 0)
         activities.top()->onResume();
-
-      delete activity;
     }
 
     /**
@@ -767,6 +1487,8 @@ namespace swoosh {
     void onDraw(sf::RenderTexture& surface) override {
       surface.draw(drawable);
     }
+
+    bool isStatic() const override { return true; } // the copied framebuffer never changes
   }; // CopyWindow
 
   // deferred implementation
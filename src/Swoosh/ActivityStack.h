@@ -0,0 +1,171 @@
+#pragma once
+#include "Activity.h"
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <typeindex>
+#include <typeinfo>
+#include <cstddef>
+
+namespace swoosh {
+  /**
+    @class ActivityStack
+    @brief A contiguous stack of owned activities with an index of where the activities of each queried type live
+
+    The back of the container is the top of the stack.
+    The first time a type T is looked up, the stack is scanned once for activities that are T or derive from T.
+    From then on every push checks the new activity against each type looked up so far, once per dynamic type,
+    so finding the topmost match of T is O(1) no matter how deep the stack is or whether T is a base class.
+    Only the top can be pushed or popped, which keeps every index sorted without any searching.
+
+    This is used internally by the ActivityController
+  */
+  class ActivityStack {
+  public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1); //!< Returned by find() when nothing matches
+
+  private:
+    /**
+      @class Query
+      @brief Ascending stack positions of the activities that are a type T or derive from it
+    */
+    struct Query {
+      bool (*matches)(const Activity*){ nullptr }; //!< dynamic_cast to T
+      std::unordered_map<std::type_index, bool> verdicts; //!< If each dynamic type seen so far is a T
+      std::vector<std::size_t> positions;
+
+      void index(const Activity* activity, std::size_t pos) {
+        auto [iter, inserted] = verdicts.try_emplace(std::type_index(typeid(*activity)), false);
+
+        if (inserted) {
+          iter->second = matches(activity);
+        }
+
+        if (iter->second) {
+          positions.push_back(pos);
+        }
+      }
+    };
+
+    std::vector<std::unique_ptr<Activity>> items; //!< Owned activities, bottom to top
+    mutable std::unordered_map<std::type_index, Query> queries; //!< Index per type looked up so far
+
+    template<typename T>
+    static bool is(const Activity* activity) {
+      return dynamic_cast<const T*>(activity) != nullptr;
+    }
+
+    /**
+      @brief Returns the index of T, building it from the stack the first time T is looked up
+    */
+    template<typename T>
+    const Query& query() const {
+      auto [iter, inserted] = queries.try_emplace(std::type_index(typeid(T)));
+      Query& q = iter->second;
+
+      if (inserted) {
+        q.matches = &is<T>;
+
+        for (std::size_t i = 0; i < items.size(); i++) {
+          q.index(items[i].get(), i);
+        }
+      }
+
+      return q;
+    }
+
+  public:
+    ActivityStack() = default;
+    ActivityStack(const ActivityStack& rhs) = delete;
+    ActivityStack& operator=(const ActivityStack& rhs) = delete;
+
+    /**
+      @brief Destroys activities from the top down
+    */
+    ~ActivityStack() {
+      truncate(0);
+    }
+
+    /**
+      @brief Pushes an activity on top of the stack and takes ownership of it
+    */
+    void push(std::unique_ptr<Activity> activity) {
+      for (auto& [type, q] : queries) {
+        q.index(activity.get(), items.size());
+      }
+
+      items.push_back(std::move(activity));
+    }
+
+    /**
+      @brief Pushes an activity on top of the stack and takes ownership of it
+    */
+    void push(Activity* activity) {
+      push(std::unique_ptr<Activity>(activity));
+    }
+
+    /**
+      @brief Removes the top activity and hands ownership back to the caller
+    */
+    std::unique_ptr<Activity> pop() {
+      std::size_t pos = items.size() - 1;
+
+      // The top is the greatest position in every index it is in
+      for (auto& [type, q] : queries) {
+        if (!q.positions.empty() && q.positions.back() == pos) {
+          q.positions.pop_back();
+        }
+      }
+
+      std::unique_ptr<Activity> activity = std::move(items.back());
+      items.pop_back();
+      return activity;
+    }
+
+    /**
+      @brief Destroys every activity above the first `count` activities, top down
+      @param count. The size of the stack afterwards
+
+      No lifecycle events are called. Callers are expected to end the activities first.
+    */
+    void truncate(std::size_t count) {
+      while (items.size() > count) {
+        pop();
+      }
+    }
+
+    Activity* top() const { return items.back().get(); }
+    Activity* at(std::size_t pos) const { return items[pos].get(); }
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    /**
+      @brief Finds the position of the topmost activity that is a T or derives from T
+      @return the position from the bottom of the stack or `npos` if not found
+
+      O(1) after the first lookup of T, which scans the stack once.
+    */
+    template<typename T>
+    std::size_t find() const {
+      const Query& q = query<T>();
+      return q.positions.empty() ? npos : q.positions.back();
+    }
+
+    /**
+      @brief Finds the position of the topmost activity below `end` that is a T or derives from T
+      @return the position from the bottom of the stack or `npos` if not found
+
+      O(log n) after the first lookup of T
+    */
+    template<typename T>
+    std::size_t findBelow(std::size_t end) const {
+      const Query& q = query<T>();
+      auto iter = std::lower_bound(q.positions.begin(), q.positions.end(), end);
+
+      if (iter == q.positions.begin()) return npos;
+
+      return *(iter - 1);
+    }
+  };
+}
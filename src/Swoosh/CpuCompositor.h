@@ -0,0 +1,381 @@
+#pragma once
+#include "WorkerPool.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWOOSH_CPU_SSE2 1
+#endif
+
+namespace swoosh {
+  /**
+    @class CpuCompositor
+    @brief Composites segue captures on the CPU for machines where shaders are disabled
+
+    The captures are read back into images, every row of the output is built by a kernel from the cpu namespace,
+    and the result is uploaded into a texture once per frame. Rows are split into bands across a WorkerPool.
+
+    Reading a capture back stalls on the GPU, so captures are only read again when the segue redraws them.
+    See: Segue::getCaptureCount()
+
+    e.g.
+      compositor.read(last, next, getCaptureCount());
+      cpu::radialCCW(compositor, alpha);
+      compositor.draw(surface);
+  */
+  class CpuCompositor {
+  public:
+    /**
+      @brief Which capture a kernel reads from
+    */
+    enum class source : int {
+      last = 0,
+      next
+    };
+
+    static constexpr unsigned int band = 16; //!< Rows each worker takes at a time
+
+  private:
+    WorkerPool& pool;
+    sf::Image captures[2]; //!< Read back captures of the last and next activity
+    std::size_t version{ static_cast<std::size_t>(-1) }; //!< Capture count the images were read at
+    std::vector<sf::Uint8> pixels; //!< Composited RGBA8 output
+    sf::Texture texture; //!< Output uploaded once per frame
+    sf::Vector2u size;
+
+  public:
+    explicit CpuCompositor(WorkerPool& pool = WorkerPool::shared()) : pool(pool) { }
+
+    CpuCompositor(const CpuCompositor& rhs) = delete;
+    CpuCompositor& operator=(const CpuCompositor& rhs) = delete;
+
+    /**
+      @brief Reads both captures back if they were redrawn since the last read
+      @param version. Changes every time a capture is redrawn e.g. Segue::getCaptureCount()
+    */
+    void read(const sf::Texture& last, const sf::Texture& next, std::size_t version) {
+      if (this->version == version) return;
+
+      captures[static_cast<int>(source::last)] = last.copyToImage();
+      captures[static_cast<int>(source::next)] = next.copyToImage();
+      this->version = version;
+      resize(last.getSize());
+    }
+
+    /**
+      @brief Reads one capture back if it was redrawn since the last read. Kernels read it as source::last.
+    */
+    void read(const sf::Texture& capture, std::size_t version) {
+      if (this->version == version) return;
+
+      captures[static_cast<int>(source::last)] = capture.copyToImage();
+      this->version = version;
+      resize(capture.getSize());
+    }
+
+    const sf::Vector2u getSize() const {
+      return size;
+    }
+
+    /**
+      @brief Returns row `y` of a capture. Row 0 is the top of the screen.
+    */
+    const sf::Uint8* row(source from, unsigned int y) const {
+      const sf::Image& image = captures[static_cast<int>(from)];
+      return image.getPixelsPtr() + static_cast<std::size_t>(y) * image.getSize().x * 4u;
+    }
+
+    /**
+      @brief Calls `fn(y, out)` for every output row across the pool. `out` points at the row's RGBA8 pixels.
+    */
+    template<typename Fn>
+    void compose(Fn&& fn) {
+      if (size.x == 0 || size.y == 0) return;
+
+      std::size_t bands = (size.y + band - 1) / band;
+      std::size_t stride = static_cast<std::size_t>(size.x) * 4u;
+      sf::Uint8* output = pixels.data();
+      unsigned int height = size.y;
+
+      pool.parallelFor(bands, [&fn, output, stride, height](std::size_t b) {
+        unsigned int begin = static_cast<unsigned int>(b) * band;
+        unsigned int end = std::min(begin + band, height);
+
+        for (unsigned int y = begin; y < end; y++) {
+          fn(y, output + y * stride);
+        }
+      });
+    }
+
+    /**
+      @brief Uploads the composited pixels and draws them over the surface
+    */
+    void draw(sf::RenderTexture& surface) {
+      if (size.x == 0 || size.y == 0) return;
+
+      texture.update(pixels.data());
+      surface.draw(sf::Sprite(texture));
+    }
+
+  private:
+    void resize(const sf::Vector2u& size) {
+      if (this->size == size) return;
+
+      this->size = size;
+      pixels.assign(static_cast<std::size_t>(size.x) * size.y * 4u, 0);
+      texture.create(size.x, size.y);
+    }
+  };
+
+  /**
+    @brief Kernels that reproduce the shader effects of the segues on the CPU
+
+    Positions are worked out in the same texture coordinates the shaders see at each pixel centre, and captures are
+    sampled with the nearest pixel like the unsmoothed capture textures. Results are deterministic but drivers round
+    transcendental functions differently, so edges can land a pixel away from the GPU output.
+  */
+  namespace cpu {
+    namespace detail {
+      inline float smoothstep(float edge0, float edge1, float x) {
+        float t = std::min(std::max((x - edge0) / (edge1 - edge0), 0.0f), 1.0f);
+        return t * t * (3.0f - 2.0f * t);
+      }
+
+      inline float fract(float x) {
+        return x - std::floor(x);
+      }
+
+      /**
+        @brief Texture coordinate of pixel `i` of `count` at its centre
+      */
+      inline float coord(unsigned int i, unsigned int count) {
+        return (static_cast<float>(i) + 0.5f) / static_cast<float>(count);
+      }
+
+      /**
+        @brief Captures are render textures so their texture coordinates run bottom to top
+      */
+      inline float coordY(unsigned int y, unsigned int height) {
+        return 1.0f - coord(y, height);
+      }
+
+      /**
+        @brief Nearest pixel of a texture coordinate, clamped to the edge like an unrepeated texture
+      */
+      inline unsigned int nearest(float t, unsigned int count) {
+        float i = std::floor(t * static_cast<float>(count));
+        return static_cast<unsigned int>(std::min(std::max(i, 0.0f), static_cast<float>(count - 1)));
+      }
+
+      inline unsigned int nearestY(float t, unsigned int height) {
+        return nearest(1.0f - t, height);
+      }
+
+      /**
+        @brief Per thread scratch rows so kernels do not allocate every frame
+      */
+      struct Scratch {
+        std::vector<float> weights;
+        std::vector<sf::Uint8> a, b;
+
+        static Scratch& get(unsigned int width) {
+          static thread_local Scratch scratch;
+          scratch.weights.resize(width);
+          scratch.a.resize(static_cast<std::size_t>(width) * 4u);
+          scratch.b.resize(static_cast<std::size_t>(width) * 4u);
+          return scratch;
+        }
+      };
+
+      inline int fixedWeight(float weight) {
+        // nearbyint rounds half to even like _mm_cvtps_epi32 so both paths give the same pixels
+        return static_cast<int>(std::nearbyint(std::min(std::max(weight, 0.0f), 1.0f) * 256.0f));
+      }
+    }
+
+    /**
+      @brief Blends rows of RGBA8 pixels: out = a * (1 - weight) + b * weight for each pixel's weight in [0, 1]
+
+      Weights are rounded to 1/256. Uses SSE2 when the target has it. The scalar path gives the same result.
+    */
+    inline void blend(const sf::Uint8* a, const sf::Uint8* b, const float* weight, sf::Uint8* out, std::size_t count) {
+      std::size_t i = 0;
+
+#ifdef SWOOSH_CPU_SSE2
+      const __m128 zero = _mm_setzero_ps();
+      const __m128 one = _mm_set1_ps(1.0f);
+      const __m128 scale = _mm_set1_ps(256.0f);
+      const __m128i full = _mm_set1_epi16(256);
+      const __m128i half = _mm_set1_epi16(128);
+      const __m128i none = _mm_setzero_si128();
+
+      // 4 pixels at a time
+      for (; i + 4 <= count; i += 4) {
+        __m128 wf = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(weight + i), zero), one);
+        __m128i w32 = _mm_cvtps_epi32(_mm_mul_ps(wf, scale));
+        __m128i w16 = _mm_packs_epi32(w32, w32);   // w0 w1 w2 w3 w0 w1 w2 w3
+        w16 = _mm_unpacklo_epi16(w16, w16);        // w0 w0 w1 w1 w2 w2 w3 w3
+        __m128i wlo = _mm_unpacklo_epi32(w16, w16); // w0 x4, w1 x4
+        __m128i whi = _mm_unpackhi_epi32(w16, w16); // w2 x4, w3 x4
+
+        __m128i pa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i * 4));
+        __m128i pb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i * 4));
+
+        __m128i alo = _mm_unpacklo_epi8(pa, none), ahi = _mm_unpackhi_epi8(pa, none);
+        __m128i blo = _mm_unpacklo_epi8(pb, none), bhi = _mm_unpackhi_epi8(pb, none);
+
+        // a * (256 - w) + b * w fits in 16 unsigned bits
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(alo, _mm_sub_epi16(full, wlo)), _mm_mullo_epi16(blo, wlo));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(ahi, _mm_sub_epi16(full, whi)), _mm_mullo_epi16(bhi, whi));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, half), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, half), 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_packus_epi16(lo, hi));
+      }
+#endif
+
+      for (; i < count; i++) {
+        int w = detail::fixedWeight(weight[i]);
+
+        for (std::size_t c = 0; c < 4; c++) {
+          int pa = a[i * 4 + c], pb = b[i * 4 + c];
+          out[i * 4 + c] = static_cast<sf::Uint8>((pa * (256 - w) + pb * w + 128) >> 8);
+        }
+      }
+    }
+
+    /**
+      @brief CheckerboardCustom: cells of the next capture fade in over the last in random order
+    */
+    inline void checkerboard(CpuCompositor& compositor, int cols, int rows, float progress, float smoothness) {
+      sf::Vector2u size = compositor.getSize();
+
+      compositor.compose([&](unsigned int y, sf::Uint8* out) {
+        detail::Scratch& scratch = detail::Scratch::get(size.x);
+        float cellY = std::floor(static_cast<float>(rows) * detail::coordY(y, size.y));
+
+        for (unsigned int x = 0; x < size.x; x++) {
+          float cellX = std::floor(static_cast<float>(cols) * detail::coord(x, size.x));
+          float r = detail::fract(std::sin(cellX * 12.9898f + cellY * 78.233f) * 43758.5453f);
+          scratch.weights[x] = detail::smoothstep(0.0f, -smoothness, r - (progress * (1.0f + smoothness)));
+        }
+
+        blend(compositor.row(CpuCompositor::source::last, y), compositor.row(CpuCompositor::source::next, y), scratch.weights.data(), out, size.x);
+      });
+    }
+
+    /**
+      @brief CircleOpen and CircleClose: shows `inside` within a centred circle and the other capture around it
+      @param radius. Radius of the circle in texture coordinates of the shorter side
+      @param ratio. Width over height of the window
+    */
+    inline void circle(CpuCompositor& compositor, CpuCompositor::source inside, float radius, float ratio) {
+      sf::Vector2u size = compositor.getSize();
+      CpuCompositor::source outside = inside == CpuCompositor::source::next ? CpuCompositor::source::last : CpuCompositor::source::next;
+
+      compositor.compose([&](unsigned int y, sf::Uint8* out) {
+        detail::Scratch& scratch = detail::Scratch::get(size.x);
+        float dy = detail::coordY(y, size.y) - 0.5f;
+
+        if (ratio < 1.0f) dy *= 1.0f / ratio;
+
+        for (unsigned int x = 0; x < size.x; x++) {
+          float dx = detail::coord(x, size.x) - 0.5f;
+
+          if (ratio >= 1.0f) dx *= ratio;
+
+          scratch.weights[x] = dx * dx + dy * dy < radius * radius ? 1.0f : 0.0f;
+        }
+
+        blend(compositor.row(outside, y), compositor.row(inside, y), scratch.weights.data(), out, size.x);
+      });
+    }
+
+    /**
+      @brief DiamondTileSwipe: black diamonds grow across the capture read as source::last
+      @param direction. The types::direction the diamonds sweep in
+    */
+    inline void diamondTileSwipe(CpuCompositor& compositor, int direction, float time) {
+      sf::Vector2u size = compositor.getSize();
+      float range = 0.5f * (1.0f - time) + 2.25f * time;
+
+      compositor.compose([&](unsigned int y, sf::Uint8* out) {
+        detail::Scratch& scratch = detail::Scratch::get(size.x);
+        float v = detail::coordY(y, size.y);
+        float py = std::abs(v * 30.0f - 2.0f * std::floor(v * 15.0f) - 1.0f);
+
+        for (unsigned int x = 0; x < size.x; x++) {
+          float u = detail::coord(x, size.x);
+          float px = std::abs(u * 40.0f - 2.0f * std::floor(u * 20.0f) - 1.0f);
+          float along = direction == 1 ? u : direction == 2 ? 1.0f - v : direction == 3 ? v : 1.0f - u;
+          float reach = std::abs(std::pow(range - along, 3.0f));
+
+          scratch.weights[x] = px + py < reach ? 1.0f : 0.0f;
+        }
+
+        // the second row is opaque black
+        for (unsigned int x = 0; x < size.x; x++) {
+          scratch.b[x * 4 + 0] = scratch.b[x * 4 + 1] = scratch.b[x * 4 + 2] = 0;
+          scratch.b[x * 4 + 3] = 255;
+        }
+
+        blend(compositor.row(CpuCompositor::source::last, y), scratch.b.data(), scratch.weights.data(), out, size.x);
+      });
+    }
+
+    /**
+      @brief RadialCCW: the next capture sweeps over the last like a clock hand
+    */
+    inline void radialCCW(CpuCompositor& compositor, float time) {
+      sf::Vector2u size = compositor.getSize();
+      const float PI = 3.141592653589f;
+      float angle = (1.0f - time - 0.5f) * PI * 2.5f;
+
+      compositor.compose([&](unsigned int y, sf::Uint8* out) {
+        detail::Scratch& scratch = detail::Scratch::get(size.x);
+        float ry = detail::coordY(y, size.y) * 2.0f - 1.0f;
+
+        for (unsigned int x = 0; x < size.x; x++) {
+          float rx = detail::coord(x, size.x) * 2.0f - 1.0f;
+
+          // smoothstep(0.0, 0.0, d) in the shader is a step at 0
+          scratch.weights[x] = std::atan2(ry, rx) - angle > 0.0f ? 1.0f : 0.0f;
+        }
+
+        blend(compositor.row(CpuCompositor::source::last, y), compositor.row(CpuCompositor::source::next, y), scratch.weights.data(), out, size.x);
+      });
+    }
+
+    /**
+      @brief DreamCustom: both captures wiggle vertically while the next fades in
+      @param power. Wiggle power of the segue
+    */
+    inline void dream(CpuCompositor& compositor, float alpha, int power) {
+      sf::Vector2u size = compositor.getSize();
+
+      compositor.compose([&](unsigned int y, sf::Uint8* out) {
+        detail::Scratch& scratch = detail::Scratch::get(size.x);
+        float v = detail::coordY(y, size.y);
+
+        for (unsigned int x = 0; x < size.x; x++) {
+          float u = detail::coord(x, size.x);
+          float offsetLast = 0.03f * alpha * std::cos(static_cast<float>(power) * (alpha + u));
+          float offsetNext = 0.03f * (1.0f - alpha) * std::cos(static_cast<float>(power) * ((1.0f - alpha) + u));
+          unsigned int sx = detail::nearest(u, size.x);
+
+          const sf::Uint8* pl = compositor.row(CpuCompositor::source::last, detail::nearestY(v + offsetLast, size.y)) + sx * 4;
+          const sf::Uint8* pn = compositor.row(CpuCompositor::source::next, detail::nearestY(v + offsetNext, size.y)) + sx * 4;
+          std::copy(pl, pl + 4, scratch.a.begin() + x * 4);
+          std::copy(pn, pn + 4, scratch.b.begin() + x * 4);
+          scratch.weights[x] = alpha;
+        }
+
+        blend(scratch.a.data(), scratch.b.data(), scratch.weights.data(), out, size.x);
+      });
+    }
+  }
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace swoosh {
   namespace ease {
@@ -163,5 +166,243 @@ namespace swoosh {
       x = std::min(1.0, std::max(x, 0.0)); // limit x between [0,1] values
       return x;
     }
+
+    /**
+      @brief Curves that can be evaluated in batches with apply() or sampled into a Table
+    */
+    enum class curve : unsigned char {
+      linear,           //!< Uses power
+      inOut,
+      wideParabola,     //!< Uses power
+      bezierPopIn,
+      bezierPopOut,
+      sinuoidBounceOut,
+      wane              //!< Uses power as the factor
+    };
+
+    /**
+      @brief Calls the scalar function for the curve. Used to build tables and as the reference for apply().
+    */
+    template<typename T>
+    static T evaluate(curve c, T delta, T length, T power) {
+      switch (c) {
+      case curve::linear:           return linear(delta, length, power);
+      case curve::inOut:            return inOut(delta, length);
+      case curve::wideParabola:     return wideParabola(delta, length, power);
+      case curve::bezierPopIn:      return bezierPopIn(delta, length);
+      case curve::bezierPopOut:     return bezierPopOut(delta, length);
+      case curve::sinuoidBounceOut: return sinuoidBounceOut(delta, length);
+      case curve::wane:             return static_cast<T>(wane(delta, length, power));
+      }
+
+      return T();
+    }
+
+    namespace detail {
+      template<int Power>
+      constexpr float powi(float x) {
+        float y = 1.0f;
+        for (int i = 0; i < Power; i++) y *= x;
+        return y;
+      }
+
+      /**
+        @brief Calls fn with std::integral_constant<int, P> if power is the whole number P in [0, 8]
+        @return false if power is not one of them
+      */
+      template<typename Fn, int... P>
+      static bool withPower(float power, Fn&& fn, std::integer_sequence<int, P...>) {
+        return ((power == static_cast<float>(P) ? (fn(std::integral_constant<int, P>()), true) : false) || ...);
+      }
+
+      template<typename Fn>
+      static bool withPower(float power, Fn&& fn) {
+        return withPower(power, std::forward<Fn>(fn), std::make_integer_sequence<int, 9>());
+      }
+
+      /*
+      The loops below have no branches or calls so compilers vectorize them. Each mirrors its scalar curve
+      in single precision, including only clamping at the top of the domain.
+      */
+
+      static void inOutBatch(const float* delta, float* out, std::size_t count, float normal) {
+        for (std::size_t i = 0; i < count; i++) {
+          float x = std::min(delta[i] * normal, 1.0f);
+          out[i] = (2.0f - std::fabs(2.0f - x * 4.0f)) * 0.5f;
+        }
+      }
+
+      static void bezierPopInBatch(const float* delta, float* out, std::size_t count, float normal) {
+        for (std::size_t i = 0; i < count; i++) {
+          float x = std::min(delta[i] * normal, 1.0f);
+          float x2 = x * x;
+          out[i] = 3.0f * x2 - 2.0f * x2 * x2;
+        }
+      }
+
+      static void bezierPopOutBatch(const float* delta, float* out, std::size_t count, float normal) {
+        for (std::size_t i = 0; i < count; i++) {
+          float x = 1.0f - std::min(delta[i] * normal, 1.0f);
+          float x2 = x * x;
+          out[i] = 3.0f * x2 - 2.0f * x2 * x2;
+        }
+      }
+
+      template<int Power>
+      static void linearBatch(const float* delta, float* out, std::size_t count, float normal) {
+        for (std::size_t i = 0; i < count; i++) {
+          out[i] = powi<Power>(std::min(delta[i] * normal, 1.0f));
+        }
+      }
+
+      template<int Power>
+      static void wideParabolaBatch(const float* delta, float* out, std::size_t count, float normal) {
+        for (std::size_t i = 0; i < count; i++) {
+          float x = std::min(delta[i] * normal, 2.0f) - 1.0f;
+          out[i] = 1.0f - powi<Power>(x * x);
+        }
+      }
+    }
+
+    /**
+      @brief Evaluates the curve for every delta. The same as calling the scalar function for each one.
+      @param c. The curve
+      @param delta. `count` time values
+      @param out. `count` results. May be the same array as `delta`.
+      @param count. Number of values
+      @param length. Length of the curve, shared by every value
+      @param power. Power or factor of the curve, shared by every value. Ignored by curves without one.
+
+      linear and wideParabola with a whole power up to 8, inOut, and the bezier curves run in single precision
+      and are vectorized by the compiler. They are within 1e-6 of the scalar functions for deltas in [0, length].
+      sinuoidBounceOut, wane, and fractional powers call the scalar function for each value. Sample them
+      from a Table when they are hot.
+    */
+    static void apply(curve c, const float* delta, float* out, std::size_t count, float length, float power = 1.0f) {
+      float normal = 1.0f / length;
+
+      switch (c) {
+      case curve::inOut:
+        detail::inOutBatch(delta, out, count, normal);
+        return;
+      case curve::bezierPopIn:
+        detail::bezierPopInBatch(delta, out, count, normal);
+        return;
+      case curve::bezierPopOut:
+        detail::bezierPopOutBatch(delta, out, count, normal);
+        return;
+      case curve::linear:
+        if (detail::withPower(power, [&](auto P) { detail::linearBatch<decltype(P)::value>(delta, out, count, normal); })) return;
+        break;
+      case curve::wideParabola:
+        if (detail::withPower(power, [&](auto P) { detail::wideParabolaBatch<decltype(P)::value>(delta, out, count, normal * 2.0f); })) return;
+        break;
+      default:
+        break;
+      }
+
+      for (std::size_t i = 0; i < count; i++) {
+        out[i] = evaluate<float>(c, delta[i], length, power);
+      }
+    }
+
+    /**
+      @class Table
+      @brief A curve sampled at N + 1 evenly spaced points over [0, length] and read back with linear interpolation
+
+      Tables are built once, either at runtime from any curve or at compile time from the polynomial curves
+      with make(). Sampling is one multiply and one lerp regardless of how expensive the curve is.
+
+      Deltas are clamped to [0, length]. The error of linear interpolation is at most h^2/8 * max|f''|
+      where h = 1/N, so it grows with the power of the curve. With the default N = 256 every curve
+      with a power up to 3 is within 3e-4 of the scalar function, and within 5e-5 with a power of 1.
+      wane is the exception. Its log is steep near zero and errs up to 1e-2 with small factors, so give it a larger N.
+    */
+    template<std::size_t N = 256>
+    class Table {
+      static_assert(N > 0, "A table needs at least one interval");
+
+      float samples[N + 1]{};
+
+      template<curve C, int Power>
+      static constexpr double polynomial(double x) {
+        double y = 1.0;
+
+        if constexpr (C == curve::linear) {
+          for (int i = 0; i < Power; i++) y *= x;
+        }
+        else if constexpr (C == curve::inOut) {
+          double d = 2.0 - x * 4.0;
+          y = (2.0 - (d < 0 ? -d : d)) / 2.0;
+        }
+        else if constexpr (C == curve::wideParabola) {
+          double poly = (x * 2.0 - 1.0) * (x * 2.0 - 1.0);
+          for (int i = 0; i < Power; i++) y *= poly;
+          y = 1.0 - y;
+        }
+        else if constexpr (C == curve::bezierPopIn) {
+          y = 3.0 * x * x - 2.0 * x * x * x * x;
+        }
+        else {
+          double u = 1.0 - x;
+          y = 3.0 * u * u - 2.0 * u * u * u * u;
+        }
+
+        return y;
+      }
+
+    public:
+      constexpr Table() = default;
+
+      /**
+        @brief Samples any curve at runtime
+      */
+      Table(curve c, float power = 1.0f) {
+        for (std::size_t i = 0; i <= N; i++) {
+          samples[i] = static_cast<float>(evaluate<double>(c, static_cast<double>(i) / N, 1.0, power));
+        }
+      }
+
+      /**
+        @brief Samples a polynomial curve at compile time e.g. static constexpr auto popIn = ease::Table<>::make<ease::curve::bezierPopIn>();
+      */
+      template<curve C, int Power = 1>
+      static constexpr Table make() {
+        static_assert(C != curve::sinuoidBounceOut && C != curve::wane, "Only polynomial curves can be sampled at compile time");
+        static_assert(Power >= 0, "Power must be a whole number >= 0");
+
+        Table table;
+
+        for (std::size_t i = 0; i <= N; i++) {
+          table.samples[i] = static_cast<float>(polynomial<C, Power>(static_cast<double>(i) / N));
+        }
+
+        return table;
+      }
+
+      constexpr float sample(float delta, float length) const {
+        float u = std::min(std::max(delta / length, 0.0f), 1.0f) * N;
+        std::size_t i = std::min(static_cast<std::size_t>(u), N - 1);
+        float t = u - static_cast<float>(i);
+        return samples[i] + (samples[i + 1] - samples[i]) * t;
+      }
+
+      constexpr float operator()(float delta, float length) const {
+        return sample(delta, length);
+      }
+
+      /**
+        @brief Samples the table for every delta
+      */
+      void apply(const float* delta, float* out, std::size_t count, float length) const {
+        float scale = static_cast<float>(N) / length;
+
+        for (std::size_t i = 0; i < count; i++) {
+          float u = std::min(std::max(delta[i] * scale, 0.0f), static_cast<float>(N));
+          std::size_t k = std::min(static_cast<std::size_t>(u), N - 1);
+          out[i] = samples[k] + (samples[k + 1] - samples[k]) * (u - static_cast<float>(k));
+        }
+      }
+    };
   }
 }
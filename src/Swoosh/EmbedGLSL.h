@@ -1,76 +1,121 @@
 #pragma once
+#include <cstddef>
+#include <cstring>
+#include <iostream>
 #include <sstream>
+#include <string>
+#include <string_view>
 
 /**
  * This file includes a macro that parses GLSL input to be used by shader program compilers
- * This macro allows us to use IDE highlighting and embed readable GLSL scripts in our source files 
+ * This macro allows us to use IDE highlighting and embed readable GLSL scripts in our source files
+ *
+ * Formatting happens at compile time. GLSL(...) yields a reference to a glsl::Source in static storage,
+ * so embedding a shader costs no allocation or parsing when the segue is constructed.
  */
 
-#ifdef WIN32
-#define SWOOSH_GLSL_USE_SAFE 1
-#endif
+namespace swoosh {
+  namespace glsl {
+    /**
+      @class Source
+      @brief Null terminated GLSL source of length N formatted at compile time
+
+      Converts implicitly to std::string_view and std::string so it can be handed to ShaderCache or sf::Shader directly.
+    */
+    template<std::size_t N>
+    class Source {
+    private:
+      char data[N + 1]{};
+
+    public:
+      template<typename Buffer>
+      constexpr Source(const Buffer& formatted) {
+        for (std::size_t i = 0; i < N; i++) {
+          data[i] = formatted.data[i];
+        }
+      }
 
-// linux and other
-#ifndef SWOOSH_GLSL_USE_SAFE
-#define SWOOSH_GLSL_USE_SAFE 0
-#endif
+      constexpr std::size_t size() const { return N; }
+      constexpr const char* c_str() const { return data; }
+      constexpr std::string_view view() const { return std::string_view(data, N); }
 
-#if SWOOSH_GLSL_USE_SAFE
-#include <sstream>
-#include <cstring>
-#else
-#include <string.h>
-#endif
+      constexpr operator std::string_view() const { return view(); }
+      operator std::string() const { return std::string(data, N); }
+    };
 
-#include <iostream>
+    namespace detail {
+      template<std::size_t N>
+      struct Buffer {
+        char data[N]{};
+        std::size_t length{};
+      };
 
-namespace swoosh {
-  namespace glsl{
-    static std::string formatGLSL(const char* glsl) {
-      std::stringstream ss;
+      constexpr void erase(char* data, std::size_t& length, std::size_t pos, std::size_t count) {
+        for (std::size_t i = pos; i + count < length; i++) {
+          data[i] = data[i + count];
+        }
+
+        length -= count;
+      }
 
-#if !SWOOSH_GLSL_USE_SAFE
-      char* input = new char[strlen(glsl) + 1];
-      char delim[] = ";";
-      strcpy(input, glsl);
+      /**
+        @brief Puts every statement on its own line and strips the quotes left over from stringifying the macro input
+        @return the length written to `out`, which must hold twice `len` characters
 
-      char* line = strtok(input, delim);
+        `raw` is `#version V\n"BODY"`. Every run of non-`;` characters is written out followed by `;\n`,
+        skipping empty runs, which is the same output the previous strtok based formatter produced.
+        Each `;` adds at most one character so the output fits in twice the input.
+      */
+      constexpr std::size_t format(const char* raw, std::size_t len, char* out) {
+        std::size_t length = 0;
+        std::size_t i = 0;
 
-      while (line != 0)
-      {
-        ss << line << ";\n";
-        line = strtok(0, delim);
-      }
+        while (i < len) {
+          while (i < len && raw[i] == ';') i++;
 
-      delete[] input;
+          if (i == len) break;
 
-#else
-      std::size_t size = strlen(glsl) + 1;
-      char* input = new char[size];
-      char delim[] = ";";
-      memcpy(input, glsl, size);
-      input[size - 1] = '\0';
+          while (i < len && raw[i] != ';') {
+            out[length++] = raw[i++];
+          }
 
-      rsize_t strmax = sizeof input;
-      char* next_token{};
+          out[length++] = ';';
+          out[length++] = '\n';
+        }
 
-      char* line = strtok_s(input, delim, &next_token);
+        std::size_t found = 0;
+        while (out[found] != '\n') found++; // the first line break ends the #version decl
 
-      while (line != 0)
-      {
-        ss << line << ";\n";
-        line = strtok_s(0, delim, &next_token);
+        erase(out, length, found + 1, 1); // erase the opening quote
+        erase(out, length, length - 3, 2); // erase the closing quote and the last delim char from macro expansion
+        return length;
       }
-#endif
 
-      std::string output = ss.str(); //Get the string stream as a std::string
-      std::size_t found = output.find('\n'); // Find the first line break, this is the #version decl
-      output.erase(found + 1, 1); // Erase this quote char
-      output.erase(output.length() - 3, 2); // Remove the quote and last delim char from macro expansion
+      template<std::size_t N>
+      constexpr Buffer<2 * N> format(const char(&raw)[N]) {
+        Buffer<2 * N> out;
+        out.length = format(raw, N - 1, out.data); // ignore the null terminator
+        return out;
+      }
+    }
+
+    /**
+      @brief Formats GLSL(...) style input at runtime
+      @deprecated GLSL(...) now formats at compile time. Kept for code that calls this directly.
+    */
+    [[deprecated("GLSL(...) formats at compile time")]]
+    inline std::string formatGLSL(const char* glsl) {
+      std::size_t len = std::strlen(glsl);
+      std::string output(2 * len, '\0');
+      output.resize(detail::format(glsl, len, output.data()));
       return output;
     }
   }
 }
 
 #define SWOOSH_EMBED_TO_STR(...) #__VA_ARGS__
-#define GLSL(version, ...)  swoosh::glsl::formatGLSL("#version " #version "\n" SWOOSH_EMBED_TO_STR(#__VA_ARGS__))
+#define GLSL(version, ...) ([]() -> const auto& { \
+    constexpr auto formatted = swoosh::glsl::detail::format("#version " #version "\n" SWOOSH_EMBED_TO_STR(#__VA_ARGS__)); \
+    static constexpr swoosh::glsl::Source<formatted.length> source(formatted); \
+    return source; \
+  }())
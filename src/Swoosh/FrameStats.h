@@ -0,0 +1,283 @@
+#pragma once
+#include "Activity.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+/*
+Define SWOOSH_FRAME_STATS as 0 before including swoosh to compile the frame profiler out.
+Every profiler call then becomes an empty inline function and getStats() reports nothing.
+*/
+#ifndef SWOOSH_FRAME_STATS
+#define SWOOSH_FRAME_STATS 1
+#endif
+
+namespace swoosh {
+  /**
+    @brief Which part of the frame a sample was taken from
+  */
+  enum class phase : int {
+    update = 0, // onUpdate() of the top activity or segue
+    draw,       // onDraw() of the top activity or segue
+    composite,  // drawing the finished surface onto the window
+    size
+  };
+
+  /**
+    @class PhaseStats
+    @brief Summary of the recent samples of one phase. Times are in milliseconds.
+  */
+  struct PhaseStats {
+    double p50{};
+    double p95{};
+    double p99{};
+    double max{};
+    std::size_t samples{}; //!< Number of samples the summary was made from
+  };
+
+  /**
+    @class FrameStats
+    @brief Timing summary for one activity or segue type
+  */
+  struct FrameStats {
+    std::string name; //!< Implementation defined type name. See: std::type_info::name()
+    PhaseStats update;
+    PhaseStats draw;
+    PhaseStats composite;
+    std::size_t frames{}; //!< Frames ended while this type was on top
+    std::size_t overBudget{}; //!< Frames that took longer than the controller's frame budget
+  };
+
+#if SWOOSH_FRAME_STATS
+  /**
+    @class SampleRing
+    @brief Fixed size ring of the most recent samples in microseconds
+
+    There is a single writer (the thread driving the controller). Samples and the write cursor are atomic
+    so another thread may summarize the ring without locking. A summary taken while samples are written
+    can mix the oldest sample with the newest, which is acceptable for statistics.
+  */
+  class SampleRing {
+  public:
+    static constexpr std::size_t capacity = 256;
+
+  private:
+    std::array<std::atomic<float>, capacity> samples{};
+    std::atomic<std::uint64_t> written{ 0 };
+
+    static double percentile(const std::vector<float>& sorted, double p) {
+      std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+      return sorted[index] / 1000.0;
+    }
+
+  public:
+    void push(float microseconds) {
+      std::uint64_t n = written.load(std::memory_order_relaxed);
+      samples[n % capacity].store(microseconds, std::memory_order_relaxed);
+      written.store(n + 1, std::memory_order_release);
+    }
+
+    PhaseStats summarize() const {
+      PhaseStats stats;
+      std::uint64_t n = written.load(std::memory_order_acquire);
+      std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(n, capacity));
+
+      if (count == 0) return stats;
+
+      std::vector<float> sorted(count);
+
+      for (std::size_t i = 0; i < count; i++) {
+        sorted[i] = samples[i].load(std::memory_order_relaxed);
+      }
+
+      std::sort(sorted.begin(), sorted.end());
+
+      stats.p50 = percentile(sorted, 0.50);
+      stats.p95 = percentile(sorted, 0.95);
+      stats.p99 = percentile(sorted, 0.99);
+      stats.max = sorted.back() / 1000.0;
+      stats.samples = count;
+      return stats;
+    }
+  };
+
+  /**
+    @class FrameProfiler
+    @brief Times each frame phase of the top activity and files the samples by activity type
+
+    Entries are created the first time a type is measured. After that, measuring costs
+    two clock reads and a hash lookup, so it is cheap enough to leave enabled.
+
+    Summaries may be taken from any thread. The map of entries is guarded by a mutex that the
+    controller only takes when the type on top changes. Samples and counters are atomic.
+
+    This is used internally by the ActivityController
+  */
+  class FrameProfiler {
+  private:
+    using clock = std::chrono::steady_clock;
+
+    struct Entry {
+      std::string name;
+      std::array<SampleRing, static_cast<std::size_t>(phase::size)> phases;
+      std::atomic<std::size_t> frames{ 0 };
+      std::atomic<std::size_t> overBudget{ 0 };
+    };
+
+    std::unordered_map<std::type_index, std::unique_ptr<Entry>> entries; //!< Samples per activity type
+    mutable std::mutex mutex; //!< Guards `entries`. Entries themselves never move.
+    const std::type_info* lastType{ nullptr }; //!< Type of the last lookup. The top rarely changes.
+    Entry* lastEntry{ nullptr }; //!< Entry of the last lookup
+    double frameTime{}; //!< Seconds measured since the last frame ended
+    double budget{ 1.0 / 60.0 }; //!< Frames longer than this many seconds are over budget
+
+    Entry* entryFor(const Activity& activity) {
+      const std::type_info& type = typeid(activity);
+
+      if (lastType && *lastType == type) return lastEntry;
+
+      std::lock_guard<std::mutex> lock(mutex);
+      std::unique_ptr<Entry>& entry = entries[std::type_index(type)];
+
+      if (!entry) {
+        entry = std::make_unique<Entry>();
+        entry->name = type.name();
+      }
+
+      lastType = &type;
+      lastEntry = entry.get();
+      return lastEntry;
+    }
+
+    static FrameStats summarize(const Entry& entry) {
+      FrameStats stats;
+      stats.name = entry.name;
+      stats.update = entry.phases[static_cast<std::size_t>(phase::update)].summarize();
+      stats.draw = entry.phases[static_cast<std::size_t>(phase::draw)].summarize();
+      stats.composite = entry.phases[static_cast<std::size_t>(phase::composite)].summarize();
+      stats.frames = entry.frames.load(std::memory_order_relaxed);
+      stats.overBudget = entry.overBudget.load(std::memory_order_relaxed);
+      return stats;
+    }
+
+  public:
+    /**
+      @class Scope
+      @brief Records the time between its construction and destruction
+    */
+    class Scope {
+      friend class FrameProfiler;
+
+      FrameProfiler& profiler;
+      SampleRing& ring;
+      clock::time_point start;
+
+      Scope(FrameProfiler& profiler, SampleRing& ring) : profiler(profiler), ring(ring), start(clock::now()) { }
+
+    public:
+      Scope(const Scope& rhs) = delete;
+      Scope& operator=(const Scope& rhs) = delete;
+
+      ~Scope() {
+        std::chrono::duration<double> elapsed = clock::now() - start;
+        ring.push(static_cast<float>(elapsed.count() * 1000000.0));
+        profiler.frameTime += elapsed.count();
+      }
+    };
+
+    /**
+      @brief Start timing a phase for the activity's type
+      @return a scope that records the sample when it goes out of scope
+    */
+    Scope measure(const Activity& activity, phase which) {
+      return Scope(*this, entryFor(activity)->phases[static_cast<std::size_t>(which)]);
+    }
+
+    /**
+      @brief Ends the frame and counts it against the activity on top
+    */
+    void endFrame(const Activity& activity) {
+      Entry* entry = entryFor(activity);
+      entry->frames.fetch_add(1, std::memory_order_relaxed);
+
+      if (frameTime > budget) {
+        entry->overBudget.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      frameTime = 0;
+    }
+
+    void setBudget(double seconds) { budget = seconds; }
+    const double getBudget() const { return budget; }
+
+    /**
+      @brief Summary for one type
+      @return empty stats if the type was never on top
+    */
+    FrameStats summarize(const std::type_index& type) const {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto iter = entries.find(type);
+
+      if (iter == entries.end()) return FrameStats();
+
+      return summarize(*iter->second);
+    }
+
+    /**
+      @brief Summaries for every type that has been on top
+    */
+    std::vector<FrameStats> summarize() const {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::vector<FrameStats> result;
+      result.reserve(entries.size());
+
+      for (auto& [type, entry] : entries) {
+        result.push_back(summarize(*entry));
+      }
+
+      return result;
+    }
+
+    /**
+      @brief Forget every sample and counter. Call from the thread driving the controller.
+    */
+    void reset() {
+      std::lock_guard<std::mutex> lock(mutex);
+      entries.clear();
+      lastType = nullptr;
+      lastEntry = nullptr;
+      frameTime = 0;
+    }
+  };
+#else
+  /*
+  The profiler is compiled out. Keep the same interface so the controller needs no #if blocks.
+  */
+  class FrameProfiler {
+  public:
+    // The destructor keeps unused scopes from warning, like the real one
+    struct Scope { ~Scope() { } };
+
+    Scope measure(const Activity&, phase) { return Scope(); }
+    void endFrame(const Activity&) { }
+    void setBudget(double seconds) { budget = seconds; }
+    const double getBudget() const { return budget; }
+    FrameStats summarize(const std::type_index&) const { return FrameStats(); }
+    std::vector<FrameStats> summarize() const { return std::vector<FrameStats>(); }
+    void reset() { }
+
+  private:
+    double budget{ 1.0 / 60.0 };
+  };
+#endif
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace swoosh {
+  /**
+    @class MeshCache
+    @brief Process-wide cache of static grid meshes keyed by their size and cell size
+
+    Vertex shader effects like glsl::PageTurn deform a grid that never changes. Building it on the CPU
+    and streaming it to the GPU every draw is wasted work, so each grid is built once, uploaded into a
+    sf::VertexBuffer, and shared by every effect that asks for the same size and cell size.
+
+    Segues pick coarser cells for lower quality modes so each quality gets its own cached grid.
+
+    Where vertex buffers are not supported the grid is kept in a sf::VertexArray instead.
+  */
+  class MeshCache {
+  public:
+    /**
+      @class Grid
+      @brief Immutable triangle grid covering [0, size] in cells of cellSize pixels
+
+      Positions are in pixels. Texture coordinates are normalized to [0, 1] across the size.
+    */
+    class Grid {
+      friend class MeshCache;
+
+    private:
+      sf::VertexBuffer buffer{ sf::Triangles, sf::VertexBuffer::Static };
+      sf::VertexArray fallback{ sf::Triangles };
+      bool resident{ false }; //!< True if the grid lives in GPU memory
+      sf::Vector2u size;
+      int cellSize{};
+
+      Grid(const sf::Vector2u& size, int cellSize) : size(size), cellSize(cellSize) {
+        int cols = static_cast<int>(size.x) / cellSize;
+        int rows = static_cast<int>(size.y) / cellSize;
+        float w = static_cast<float>(size.x), h = static_cast<float>(size.y);
+
+        // each cell has 2 triangles which have 3 points (1 point = 1 vertex)
+        std::vector<sf::Vertex> vertices;
+        vertices.reserve(static_cast<std::size_t>(cols) * rows * 6);
+
+        for (int i = 0; i < cols; i++) {
+          for (int j = 0; j < rows; j++) {
+            sf::Vector2f pos[4] = {
+              sf::Vector2f((float)i*cellSize      , (float)j*cellSize),
+              sf::Vector2f((float)i*cellSize      , (float)(j + 1)*cellSize),
+              sf::Vector2f((float)(i + 1)*cellSize, (float)(j + 1)*cellSize),
+              sf::Vector2f((float)(i + 1)*cellSize, (float)j*cellSize)
+            };
+
+            // ccw
+            int order[6] = { 0, 2, 1, 0, 3, 2 };
+
+            for (auto o : order) {
+              vertices.emplace_back(pos[o], sf::Color::White, sf::Vector2f(pos[o].x / w, pos[o].y / h));
+            }
+          }
+        }
+
+        if (sf::VertexBuffer::isAvailable() && buffer.create(vertices.size()) && buffer.update(vertices.data())) {
+          resident = true;
+          return;
+        }
+
+        fallback.resize(vertices.size());
+
+        for (std::size_t i = 0; i < vertices.size(); i++) {
+          fallback[i] = vertices[i];
+        }
+      }
+
+    public:
+      Grid(const Grid& rhs) = delete;
+      Grid& operator=(const Grid& rhs) = delete;
+
+      void draw(sf::RenderTarget& target, const sf::RenderStates& states) const {
+        if (resident) {
+          target.draw(buffer, states);
+        }
+        else {
+          target.draw(fallback, states);
+        }
+      }
+
+      const std::size_t getVertexCount() const {
+        return resident ? buffer.getVertexCount() : fallback.getVertexCount();
+      }
+
+      const bool isResident() const { return resident; }
+      const sf::Vector2u getSize() const { return size; }
+      const int getCellSize() const { return cellSize; }
+    };
+
+  private:
+    using Key = std::pair<std::pair<unsigned int, unsigned int>, int>;
+
+    struct State {
+      std::map<Key, std::shared_ptr<const Grid>> grids;
+      std::mutex mutex;
+    };
+
+    static State& state() {
+      static State instance;
+      return instance;
+    }
+
+  public:
+    /**
+      @brief Returns the grid covering `size` in cells of `cellSize` pixels. Builds and uploads it the first time.
+      @param size. Size of the grid in pixels. Cells that do not fit entirely are left out.
+      @param cellSize. Width and height of each cell in pixels. Bigger cells mean fewer vertices.
+    */
+    static std::shared_ptr<const Grid> grid(const sf::Vector2u& size, int cellSize) {
+      if (cellSize < 1) cellSize = 1;
+
+      State& s = state();
+      Key key{ { size.x, size.y }, cellSize };
+
+      std::lock_guard<std::mutex> lock(s.mutex);
+      auto iter = s.grids.find(key);
+
+      if (iter != s.grids.end()) {
+        return iter->second;
+      }
+
+      std::shared_ptr<const Grid> grid(new Grid(size, cellSize));
+      s.grids.emplace(key, grid);
+      return grid;
+    }
+
+    /**
+      @brief Query the number of grids that are cached
+    */
+    static std::size_t size() {
+      State& s = state();
+      std::lock_guard<std::mutex> lock(s.mutex);
+      return s.grids.size();
+    }
+
+    /**
+      @brief Releases every cached grid. Grids still in use are freed when their last user is.
+
+      Call this before the last GL context goes away if vertex buffers must be freed deterministically.
+      The ActivityController calls this when it is destroyed.
+    */
+    static void clear() {
+      State& s = state();
+      std::lock_guard<std::mutex> lock(s.mutex);
+      s.grids.clear();
+    }
+  };
+}
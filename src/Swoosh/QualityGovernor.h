@@ -0,0 +1,284 @@
+#pragma once
+#include "Segue.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace swoosh {
+  /**
+    @class QualityChange
+    @brief Describes one quality mode switch made by the QualityGovernor
+  */
+  struct QualityChange {
+    enum class reason : int {
+      overBudget = 0, // frames ran over the budget for too long
+      underBudget     // frames had room to spare for long enough
+    };
+
+    std::string name; //!< Implementation defined segue type name. See: std::type_info::name()
+    quality from{ quality::realtime };
+    quality to{ quality::realtime };
+    reason why{ reason::overBudget };
+    double frameTime{}; //!< Smoothed frame time in milliseconds when the switch was made
+    double budget{}; //!< Frame budget in milliseconds
+    std::size_t frames{}; //!< Frames of this segue type measured before the switch
+  };
+
+  /**
+    @class GovernorStats
+    @brief What the QualityGovernor decided for one segue type
+  */
+  struct GovernorStats {
+    std::string name; //!< Implementation defined segue type name. See: std::type_info::name()
+    quality level{ quality::realtime }; //!< Mode the segue type runs at from now on
+    std::size_t frames{}; //!< Frames measured while the segue type was on top
+    std::size_t downgrades{};
+    std::size_t upgrades{};
+    double worst{}; //!< Longest smoothed frame time in milliseconds
+  };
+
+  /**
+    @class QualityGovernor
+    @brief Switches the quality mode of each segue type from how long it takes to draw
+
+    The controller's quality mode (see ActivityController::optimizeForPerformance()) is the best mode the governor uses.
+    Only the segue's own draw is measured, not vsync waits or the rest of the app's frame, and never its first frame
+    which captures the scenes and warms up its programs. The time is taken on the CPU, so GPU work the driver queues
+    without blocking is not seen.
+
+    A segue type steps down one mode after its draws stay over the budget for a while, and steps back up after they
+    stay well under it for much longer. The gap between the two thresholds and the two delays keeps it from flipping
+    between modes every transition.
+
+    Decisions are remembered per segue type for the rest of the session, so a segue that was too slow once
+    starts in the lower mode next time. Switches can happen in the middle of a transition.
+    Segues read getRequestedQuality() every frame and pick up the new mode on the next one. Segues that build
+    something per quality mode, like the grids of Cube3D and PageTurn or the kernel of BlurFadeIn, swap it then too.
+
+    This is owned by the ActivityController. See: ActivityController::getQualityGovernor()
+  */
+  class QualityGovernor {
+  private:
+    std::unordered_map<std::type_index, GovernorStats> records; //!< Decisions per segue type
+    GovernorStats* active{ nullptr }; //!< Decision of the segue on top. nullptr outside transitions.
+    std::function<void(const QualityChange&)> callback;
+    bool enabled{ false };
+
+    double downgradeRatio{ 1.25 }; //!< Frames longer than budget * ratio count toward a downgrade
+    double upgradeRatio{ 0.5 }; //!< Frames shorter than budget * ratio count toward an upgrade
+    unsigned int downgradeAfter{ 10 }; //!< Frames in a row over budget before stepping down
+    unsigned int upgradeAfter{ 120 }; //!< Frames in a row under budget before stepping up
+
+    double smoothed{}; //!< Smoothed frame time in seconds. 0 until the first sample.
+    unsigned int over{}; //!< Frames in a row over budget
+    unsigned int under{}; //!< Frames in a row under budget
+    std::size_t downgrades{};
+    std::size_t upgrades{};
+
+    static constexpr double smoothing = 0.2; //!< Weight of the newest frame time
+
+    // Higher enum values are lower quality
+    static quality worse(quality a, quality b) {
+      return static_cast<int>(a) > static_cast<int>(b) ? a : b;
+    }
+
+    static quality shift(quality mode, int by) {
+      int level = std::min(std::max(static_cast<int>(mode) + by, static_cast<int>(quality::realtime)), static_cast<int>(quality::mobile));
+      return static_cast<quality>(level);
+    }
+
+    void change(quality from, quality to, QualityChange::reason why, double budget) {
+      GovernorStats& stats = *active;
+      stats.level = to;
+
+      if (why == QualityChange::reason::overBudget) {
+        stats.downgrades++;
+        downgrades++;
+      }
+      else {
+        stats.upgrades++;
+        upgrades++;
+      }
+
+      QualityChange event;
+      event.name = stats.name;
+      event.from = from;
+      event.to = to;
+      event.why = why;
+      event.frameTime = smoothed * 1000.0;
+      event.budget = budget * 1000.0;
+      event.frames = stats.frames;
+
+      // Measure the new mode from scratch
+      smoothed = 0.0;
+      over = under = 0;
+
+      if (callback) {
+        callback(event);
+      }
+    }
+
+  public:
+    /**
+      @brief Lets the governor pick the quality mode of each segue type. Default is disabled.
+
+      Disabling it keeps the remembered decisions. See: forget()
+    */
+    void enable(bool enabled) {
+      this->enabled = enabled;
+    }
+
+    const bool isEnabled() const {
+      return enabled;
+    }
+
+    /**
+      @brief Sets how far from the budget frames must be to count toward a switch
+      @param downgrade. Frames longer than budget * downgrade count toward stepping down. Default is 1.25
+      @param upgrade. Frames shorter than budget * upgrade count toward stepping up. Default is 0.5
+    */
+    void setThresholds(double downgrade, double upgrade) {
+      downgradeRatio = std::max(downgrade, 1.0);
+      upgradeRatio = std::min(upgrade, 1.0);
+    }
+
+    /**
+      @brief Sets how many frames in a row must cross a threshold before switching
+      @param downgrade. Default is 10
+      @param upgrade. Default is 120
+    */
+    void setDelays(unsigned int downgrade, unsigned int upgrade) {
+      downgradeAfter = std::max(downgrade, 1u);
+      upgradeAfter = std::max(upgrade, 1u);
+    }
+
+    /**
+      @brief Called every time the governor switches a segue type to another mode
+    */
+    void onChange(std::function<void(const QualityChange&)> callback) {
+      this->callback = std::move(callback);
+    }
+
+    /**
+      @brief Query the mode the governor uses while the segue on top runs
+      @param best. The controller's quality mode
+    */
+    const quality resolve(quality best) const {
+      if (!enabled || !active) return best;
+
+      return worse(best, active->level);
+    }
+
+    /**
+      @brief Starts measuring a segue type. This is used internally by the ActivityController when a segue is created.
+    */
+    void begin(const std::type_info& type) {
+      GovernorStats& stats = records[std::type_index(type)];
+
+      if (stats.name.empty()) {
+        stats.name = type.name();
+      }
+
+      active = &stats;
+      smoothed = 0.0;
+      over = under = 0;
+    }
+
+    /**
+      @brief Stops measuring. This is used internally by the ActivityController when a segue ends.
+    */
+    void end() {
+      active = nullptr;
+    }
+
+    /**
+      @brief Feeds the time the segue on top took to draw to the governor
+      @param seconds. Time the segue took to draw
+      @param budget. Target frame time in seconds
+      @param best. The controller's quality mode
+
+      This is used internally by the ActivityController every segue frame
+    */
+    void sample(double seconds, double budget, quality best) {
+      if (!enabled || !active || seconds <= 0.0 || budget <= 0.0) return;
+
+      GovernorStats& stats = *active;
+      stats.frames++;
+
+      smoothed = smoothed > 0.0 ? smoothed + (seconds - smoothed) * smoothing : seconds;
+      stats.worst = std::max(stats.worst, smoothed * 1000.0);
+
+      quality current = worse(best, stats.level);
+
+      if (smoothed > budget * downgradeRatio) {
+        under = 0;
+
+        if (++over >= downgradeAfter && current != quality::mobile) {
+          change(current, shift(current, 1), QualityChange::reason::overBudget, budget);
+        }
+      }
+      else if (smoothed < budget * upgradeRatio) {
+        over = 0;
+
+        if (++under >= upgradeAfter && current != best) {
+          change(current, shift(current, -1), QualityChange::reason::underBudget, budget);
+        }
+      }
+      else {
+        over = under = 0;
+      }
+    }
+
+    /**
+      @brief Forgets every decision so each segue type starts at the controller's mode again
+    */
+    void forget() {
+      for (auto& [type, stats] : records) {
+        stats.level = quality::realtime;
+      }
+
+      smoothed = 0.0;
+      over = under = 0;
+    }
+
+    /**
+      @brief Query the decision for segue type T
+      @return empty stats if T never ran while the governor was enabled
+    */
+    template<typename T>
+    GovernorStats getStats() const {
+      auto iter = records.find(std::type_index(typeid(T)));
+      if (iter == records.end()) return GovernorStats();
+      return iter->second;
+    }
+
+    /**
+      @brief Query the decisions for every segue type that has run
+    */
+    std::vector<GovernorStats> getStats() const {
+      std::vector<GovernorStats> result;
+      result.reserve(records.size());
+
+      for (auto& [type, stats] : records) {
+        result.push_back(stats);
+      }
+
+      return result;
+    }
+
+    /**
+      @brief Query how many times any segue type was stepped down
+    */
+    const std::size_t getDowngrades() const { return downgrades; }
+
+    /**
+      @brief Query how many times any segue type was stepped up
+    */
+    const std::size_t getUpgrades() const { return upgrades; }
+  };
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "Segue.h"
+#include <algorithm>
+#include <cmath>
+
+namespace swoosh {
+  /**
+    @class RenderScale
+    @brief Picks the resolution segues are drawn at for each quality mode and from measured frame time
+
+    Scales are fractions of the virtual window size. 1 is full resolution.
+    Only segues that enable render scaling are affected. See: Segue::enableRenderScale()
+
+    When adaptive, the scale drops while segues take longer to draw than the frame budget and creeps back up while
+    a bigger scale is predicted to fit. Fill cost grows with the area so the scale drops by the square root of how
+    far over budget the draws are. Only the segue's draw is timed, so vsync waits and the rest of the app's frame
+    do not hold the scale down. The time is taken on the CPU: GPU work the driver queues without blocking is not seen.
+
+    This is owned by the ActivityController. See: ActivityController::setRenderScale()
+  */
+  class RenderScale {
+  public:
+    static constexpr float step = 1.0f / 16.0f; //!< Scales are rounded to this so scaled surfaces are reused, not recreated
+
+  private:
+    float scales[3]{ 1.0f, 1.0f, 1.0f }; //!< Scale of each quality mode
+    bool adaptive{ false };
+    float minimum{ 0.5f }; //!< Lowest scale the adaptive controller picks
+    float current{ 1.0f }; //!< Adaptive scale before rounding
+    double smoothed{}; //!< Smoothed frame time in seconds. 0 until the first sample.
+
+    static constexpr double smoothing = 0.25; //!< Weight of the newest frame time
+    static constexpr double tolerance = 1.1; //!< Frames this far over budget lower the scale
+    static constexpr float recovery = 0.01f; //!< Scale regained every frame that fits the budget
+
+  public:
+    /**
+      @brief Clamps the scale into [step, 1]
+    */
+    static float clamp(float scale) {
+      return std::min(std::max(scale, step), 1.0f);
+    }
+
+    /**
+      @brief Rounds the scale to the nearest step
+    */
+    static float round(float scale) {
+      return clamp(std::round(scale / step) * step);
+    }
+
+    void set(quality mode, float scale) {
+      scales[static_cast<int>(mode)] = clamp(scale);
+    }
+
+    const float get(quality mode) const {
+      return scales[static_cast<int>(mode)];
+    }
+
+    void setAdaptive(bool enabled, float minimum) {
+      this->adaptive = enabled;
+      this->minimum = clamp(minimum);
+      current = 1.0f;
+      smoothed = 0.0;
+    }
+
+    const bool isAdaptive() const { return adaptive; }
+    const float getMinimum() const { return minimum; }
+    const float getAdaptive() const { return current; }
+
+    /**
+      @brief The scale to draw at this frame
+      @param ceiling. Highest scale allowed e.g. the scale of the quality mode
+    */
+    const float resolve(float ceiling) const {
+      if (!adaptive) return round(ceiling);
+
+      return round(std::min(ceiling, std::max(current, minimum)));
+    }
+
+    /**
+      @brief Feeds the time the last scaled segue took to draw to the adaptive controller
+      @param seconds. Time the segue took to draw
+      @param budget. Target frame time in seconds
+      @param ceiling. Highest scale allowed
+    */
+    void sample(double seconds, double budget, float ceiling) {
+      if (!adaptive || seconds <= 0.0 || budget <= 0.0) return;
+
+      smoothed = smoothed > 0.0 ? smoothed + (seconds - smoothed) * smoothing : seconds;
+
+      // Start from what was actually drawn so a low ceiling does not hide the drop
+      current = std::min(current, ceiling);
+
+      if (smoothed > budget * tolerance) {
+        current *= static_cast<float>(std::sqrt(budget / smoothed));
+
+        // Assume the drop worked until new frames say otherwise so it is not applied again next frame
+        smoothed = budget;
+      }
+      else {
+        // Only climb if the next step up is predicted to fit. Otherwise it would bounce between two steps.
+        float next = round(current) + step;
+        double grown = next / std::max(round(current), step);
+
+        if (smoothed * grown * grown <= budget) {
+          current += recovery;
+        }
+      }
+
+      current = std::min(std::max(current, minimum), std::max(ceiling, minimum));
+    }
+  };
+}
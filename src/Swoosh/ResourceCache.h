@@ -0,0 +1,243 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace swoosh {
+  /**
+    @class ResourceCache
+    @brief Loads media once per path and shares it between every activity that asks for it
+
+    Any type with `bool loadFromFile(const std::string&)` can be cached e.g. sf::Texture, sf::Font, sf::SoundBuffer.
+    Handles are reference counted. When the last handle is dropped the resource stays resident so pushing the same
+    activity again costs nothing. Resident resources nobody holds a handle to are evicted least recently used first
+    whenever the cache goes over its byte budget.
+
+    The cache is safe to use from prefetch threads. See: ActivityController::prefetch()
+    A path is only ever decoded once. Threads asking for a path that is still loading wait for it.
+  */
+  class ResourceCache {
+  public:
+    /**
+      @class Stats
+      @brief Counters describing how well the cache is reused
+    */
+    struct Stats {
+      std::size_t hits{};          //!< Loads satisfied by a resident resource
+      std::size_t misses{};        //!< Loads that had to read from disk
+      std::size_t evictions{};     //!< Resources freed to stay under budget
+      std::size_t resident{};      //!< Number of resources in memory
+      std::size_t bytesResident{}; //!< Estimated memory of every resident resource
+    };
+
+  private:
+    using Key = std::pair<std::type_index, std::string>;
+    using Order = std::list<Key>;
+
+    struct Entry {
+      std::shared_ptr<void> resource; //!< Shares the control block with every handle handed out. Empty while loading.
+      std::shared_future<std::shared_ptr<void>> loading; //!< Ready once the thread loading this resource is done
+      std::size_t bytes{};
+      Order::iterator position; //!< Place in the use order. Only valid once loaded.
+    };
+
+    struct KeyHash {
+      std::size_t operator()(const Key& key) const {
+        return key.first.hash_code() ^ (std::hash<std::string>()(key.second) << 1);
+      }
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    Order order; //!< Loaded resources, least recently used first
+    std::size_t budget{ 256u * 1024u * 1024u }; //!< Bytes kept resident before unused resources are evicted
+    Stats stats;
+    mutable std::mutex mutex;
+
+    /*
+    Resources that can report their size do. Everything else is estimated by its size on disk.
+    */
+    template<typename T>
+    static auto estimate(const T& resource, const std::string&, int) -> decltype(resource.getSize().x, std::size_t()) {
+      return static_cast<std::size_t>(resource.getSize().x) * static_cast<std::size_t>(resource.getSize().y) * 4u; // RGBA8
+    }
+
+    template<typename T>
+    static auto estimate(const T& resource, const std::string&, long) -> decltype(resource.getSampleCount(), std::size_t()) {
+      return static_cast<std::size_t>(resource.getSampleCount()) * sizeof(sf::Int16);
+    }
+
+    template<typename T>
+    static std::size_t estimate(const T&, const std::string& path, ...) {
+      std::ifstream file(path, std::ios::binary | std::ios::ate);
+      return file ? static_cast<std::size_t>(file.tellg()) : 0u;
+    }
+
+    /**
+      @brief Frees unused resources, least recently used first, until the cache fits in `bytes`
+      @warning Caller must hold the mutex
+    */
+    void evict(std::size_t bytes) {
+      auto position = order.begin();
+
+      while (stats.bytesResident > bytes && position != order.end()) {
+        auto victim = entries.find(*position);
+
+        if (victim->second.resource.use_count() > 1) {
+          position++; // someone still holds a handle
+          continue;
+        }
+
+        stats.bytesResident -= victim->second.bytes;
+        stats.resident--;
+        stats.evictions++;
+        position = order.erase(position);
+        entries.erase(victim);
+      }
+    }
+
+  public:
+    ResourceCache() = default;
+    ResourceCache(const ResourceCache& rhs) = delete;
+    ResourceCache& operator=(const ResourceCache& rhs) = delete;
+
+    /**
+      @brief Returns the resource at `path`, loading it only if it is not already resident
+      @return a shared handle. The resource is shared with every other activity that loaded the same path.
+      @throws std::runtime_error if the resource fails to load
+    */
+    template<typename T>
+    std::shared_ptr<T> load(const std::string& path) {
+      Key key(std::type_index(typeid(T)), path);
+      std::promise<std::shared_ptr<void>> promise;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto [iter, inserted] = entries.try_emplace(key);
+        Entry& entry = iter->second;
+
+        if (!inserted) {
+          stats.hits++;
+
+          if (entry.resource) {
+            order.splice(order.end(), order, entry.position);
+            return std::static_pointer_cast<T>(entry.resource);
+          }
+
+          // Another thread is loading it. Share theirs once it is done.
+          std::shared_future<std::shared_ptr<void>> loading = entry.loading;
+          lock.unlock();
+          return std::static_pointer_cast<T>(loading.get());
+        }
+
+        // Claim the path so no other thread decodes it too
+        entry.loading = promise.get_future().share();
+      }
+
+      // Load outside of the lock so other threads are not held up by disk access
+      std::shared_ptr<T> resource;
+      std::size_t bytes{};
+
+      try {
+        resource = std::make_shared<T>();
+
+        if (!resource->loadFromFile(path)) {
+          throw std::runtime_error("Resource at " + path + " failed to load");
+        }
+
+        bytes = estimate(*resource, path, 0);
+      }
+      catch (...) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          entries.erase(key);
+        }
+
+        promise.set_exception(std::current_exception());
+        throw;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        Entry& entry = entries.find(key)->second;
+        entry.resource = resource;
+        entry.loading = {}; // the future holds a handle too and would keep the resource from being evicted
+        entry.bytes = bytes;
+        entry.position = order.insert(order.end(), key);
+        stats.misses++;
+        stats.resident++;
+        stats.bytesResident += bytes;
+
+        evict(budget);
+      }
+
+      promise.set_value(resource);
+      return resource;
+    }
+
+    /**
+      @brief Shorthand for load<sf::Texture>()
+    */
+    std::shared_ptr<sf::Texture> loadTexture(const std::string& path) {
+      return load<sf::Texture>(path);
+    }
+
+    /**
+      @brief Shorthand for load<sf::Font>()
+    */
+    std::shared_ptr<sf::Font> loadFont(const std::string& path) {
+      return load<sf::Font>(path);
+    }
+
+    /**
+      @brief Query if a resource is resident without loading it or counting a hit
+    */
+    template<typename T>
+    bool isResident(const std::string& path) const {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto iter = entries.find(Key(std::type_index(typeid(T)), path));
+      return iter != entries.end() && iter->second.resource;
+    }
+
+    /**
+      @brief Unused resources are evicted when the cache holds more than this many bytes
+      @param bytes. Default is 256 MiB
+    */
+    void setBudget(std::size_t bytes) {
+      std::lock_guard<std::mutex> lock(mutex);
+      budget = bytes;
+      evict(budget);
+    }
+
+    const std::size_t getBudget() const {
+      std::lock_guard<std::mutex> lock(mutex);
+      return budget;
+    }
+
+    /**
+      @brief Frees every resident resource that nobody holds a handle to
+    */
+    void trim() {
+      std::lock_guard<std::mutex> lock(mutex);
+      evict(0);
+    }
+
+    /**
+      @brief Query the hits, misses, evictions, and bytes resident of the cache
+    */
+    Stats getStats() const {
+      std::lock_guard<std::mutex> lock(mutex);
+      return stats;
+    }
+  };
+}
@@ -3,6 +3,8 @@
 
 #include "Timer.h"
 #include "Activity.h"
+#include <cstddef>
+#include <cmath>
 
 namespace swoosh {
   class ActivityController;
@@ -35,6 +37,14 @@ namespace swoosh {
     Activity* next;
     sf::Time duration;
     Timer timer;
+    sf::RenderTexture* lastSurface{ nullptr }; //!< Controller-owned surface for the last activity
+    sf::RenderTexture* nextSurface{ nullptr }; //!< Controller-owned surface for the next activity
+    bool lastCaptured{ false }; //!< True once the last activity has been drawn into its surface
+    bool nextCaptured{ false }; //!< True once the next activity has been drawn into its surface
+    std::size_t captureCount{ 0 }; //!< Number of times an activity was drawn into a dedicated surface
+    bool scalable{ false }; //!< True if the controller may draw this segue below full resolution
+    float renderScale{ 0.0f }; //!< Highest render scale for this segue. 0 uses the scale of the quality mode.
+    float appliedScale{ 1.0f }; //!< Render scale of the frame being drawn
 
     // Hack to make this lib header-only
     void (ActivityController::*setActivityViewFunc)(sf::RenderTexture& surface, swoosh::Activity* activity);
@@ -62,11 +72,114 @@ namespace swoosh {
       (this->getController().*resetViewFunc)(surface);
     }
 
+    /**
+      @brief Draws the last activity into its dedicated surface owned by the activity controller
+      @return the texture of the dedicated surface. This reference is stable for the lifetime of the controller.
+
+      Nothing is allocated or copied. Use this instead of copying the shared surface into a new sf::Texture.
+    */
+    const sf::Texture& drawLastActivity() {
+      drawLastActivity(*lastSurface);
+      lastSurface->display();
+      captureCount++;
+      return lastSurface->getTexture();
+    }
+
+    /**
+      @brief Draws the next activity into its dedicated surface owned by the activity controller
+      @return the texture of the dedicated surface. This reference is stable for the lifetime of the controller.
+
+      Nothing is allocated or copied. Use this instead of copying the shared surface into a new sf::Texture.
+    */
+    const sf::Texture& drawNextActivity() {
+      drawNextActivity(*nextSurface);
+      nextSurface->display();
+      captureCount++;
+      return nextSurface->getTexture();
+    }
+
+    /**
+      @brief Snapshots the last activity into its dedicated surface
+      @param cache. If true, the activity is only drawn the first time this is called in this segue
+      @return the texture of the dedicated surface, bound by reference and never copied
+
+      Static activities (see Activity::isStatic()) are only drawn once regardless of `cache`.
+      Segues typically pass `true` when the requested quality is quality::mobile.
+    */
+    const sf::Texture& captureLastActivity(bool cache) {
+      if (!lastCaptured || !(cache || (last && last->isStatic()))) {
+        drawLastActivity();
+        lastCaptured = true;
+      }
+
+      return getLastActivityTexture();
+    }
+
+    /**
+      @brief Snapshots the next activity into its dedicated surface
+      @param cache. If true, the activity is only drawn the first time this is called in this segue
+      @return the texture of the dedicated surface, bound by reference and never copied
+
+      Static activities (see Activity::isStatic()) are only drawn once regardless of `cache`.
+      Segues typically pass `true` when the requested quality is quality::mobile.
+    */
+    const sf::Texture& captureNextActivity(bool cache) {
+      if (!nextCaptured || !(cache || next->isStatic())) {
+        drawNextActivity();
+        nextCaptured = true;
+      }
+
+      return getNextActivityTexture();
+    }
+
+    /**
+      @brief Lets the controller draw this segue below full resolution. See: ActivityController::setRenderScale()
+
+      Only enable this for effects that stretch their captures over the surface they are given.
+      When scaled, the surface and both captures are smaller than the virtual window and onDraw() works in their pixels.
+    */
+    void enableRenderScale(bool enabled = true) {
+      scalable = enabled;
+    }
+
+    /**
+      @brief Caps the render scale of this segue instead of using the scale of the quality mode. Also enables render scaling.
+      @param scale. Fraction of the virtual window size in (0, 1]
+    */
+    void setRenderScale(float scale) {
+      renderScale = scale;
+      scalable = true;
+    }
+
+    /**
+      @brief Returns the contents of the last activity's dedicated surface without redrawing it
+    */
+    const sf::Texture& getLastActivityTexture() const { return lastSurface->getTexture(); }
+
+    /**
+      @brief Returns the contents of the next activity's dedicated surface without redrawing it
+    */
+    const sf::Texture& getNextActivityTexture() const { return nextSurface->getTexture(); }
+
   public:
+    /**
+      @brief Query how many times this segue drew an activity into a dedicated surface
+      
+      Each capture writes a full surface. Useful to measure the cost of an effect.
+    */
+    const std::size_t getCaptureCount() const { return captureCount; }
+
+    /**
+      @brief Query the render scale of the frame being drawn. 1 is full resolution.
+
+      Effects with sizes in pixels e.g. blur radii should multiply them by this to look the same at every scale.
+    */
+    const float getRenderScale() const { return appliedScale; }
+
     void onStart() override final { next->onEnter();  last->onLeave(); timer.start(); }
 
     void onUpdate (double elapsed) override final {
-      timer.update(sf::seconds(static_cast<float>(elapsed)));
+      timer.update(sf::microseconds(static_cast<sf::Int64>(std::llround(elapsed * 1000000.0))));
 
       last->onUpdate(elapsed);
       next->onUpdate(elapsed);
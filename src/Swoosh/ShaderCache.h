@@ -0,0 +1,151 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace swoosh {
+  /**
+    @class ShaderCache
+    @brief Process-wide cache of compiled shader programs keyed by a hash of their source
+
+    Every instance of a segue type builds the same GLSL source. Compiling and linking it again for each
+    transition makes the first frame hitch, so programs are compiled once and shared.
+
+    Because programs are shared, users must set every uniform they depend on before each draw.
+    Uniform values set by another instance may still be bound from a previous frame.
+    The swoosh::glsl wrappers only store values in their setters and upload them all in apply().
+
+    Shaders that fail to compile are cached too so a device without shader support only fails once.
+  */
+  class ShaderCache {
+  public:
+    /**
+      @class Stats
+      @brief Counters describing how well the cache is reused
+    */
+    struct Stats {
+      std::size_t hits{};     //!< Requests satisfied by an already compiled program
+      std::size_t compiles{}; //!< Programs compiled and linked
+      std::size_t failures{}; //!< Programs that failed to compile or link
+    };
+
+  private:
+    struct Entry {
+      std::string vertex;
+      std::string fragment;
+      std::shared_ptr<sf::Shader> shader;
+    };
+
+    struct State {
+      std::unordered_map<std::uint64_t, Entry> programs;
+      Stats stats;
+      std::mutex mutex;
+    };
+
+    static State& state() {
+      static State instance;
+      return instance;
+    }
+
+    /**
+      @brief 64-bit FNV-1a over both stages with a separator so stage boundaries matter
+    */
+    static std::uint64_t hash(std::string_view vertex, std::string_view fragment) {
+      std::uint64_t h = 14695981039346656037ull;
+
+      auto mix = [&h](std::string_view str) {
+        for (unsigned char c : str) {
+          h ^= c;
+          h *= 1099511628211ull;
+        }
+
+        h ^= 0xff;
+        h *= 1099511628211ull;
+      };
+
+      mix(vertex);
+      mix(fragment);
+      return h;
+    }
+
+  public:
+    /**
+      @brief Returns the compiled program for the vertex and fragment source. Compiles it the first time.
+      @param vertex. Vertex stage source. Empty for a fragment-only program.
+      @param fragment. Fragment stage source.
+
+      Sources are only copied the first time they are compiled, so GLSL(...) sources cost nothing on a hit.
+    */
+    static std::shared_ptr<sf::Shader> get(std::string_view vertex, std::string_view fragment) {
+      State& s = state();
+      std::uint64_t key = hash(vertex, fragment);
+
+      std::lock_guard<std::mutex> lock(s.mutex);
+      auto iter = s.programs.find(key);
+
+      if (iter != s.programs.end() && iter->second.vertex == vertex && iter->second.fragment == fragment) {
+        s.stats.hits++;
+        return iter->second.shader;
+      }
+
+      std::shared_ptr<sf::Shader> shader = std::make_shared<sf::Shader>();
+      bool compiled = vertex.empty() ? shader->loadFromMemory(std::string(fragment), sf::Shader::Fragment)
+                                     : shader->loadFromMemory(std::string(vertex), std::string(fragment));
+
+      s.stats.compiles++;
+
+      if (!compiled) {
+        s.stats.failures++;
+      }
+
+      // A hash collision keeps the first program cached and hands this one out uncached
+      if (iter == s.programs.end()) {
+        s.programs.emplace(key, Entry{ std::string(vertex), std::string(fragment), shader });
+      }
+
+      return shader;
+    }
+
+    /**
+      @brief Returns the compiled fragment-only program for the source. Compiles it the first time.
+    */
+    static std::shared_ptr<sf::Shader> get(std::string_view fragment) {
+      return get(std::string_view(), fragment);
+    }
+
+    /**
+      @brief Query the number of programs that are compiled and cached
+    */
+    static std::size_t size() {
+      State& s = state();
+      std::lock_guard<std::mutex> lock(s.mutex);
+      return s.programs.size();
+    }
+
+    /**
+      @brief Query the hits, compiles, and failures of the cache
+    */
+    static Stats getStats() {
+      State& s = state();
+      std::lock_guard<std::mutex> lock(s.mutex);
+      return s.stats;
+    }
+
+    /**
+      @brief Releases every cached program. Programs still in use are freed when their last user is.
+
+      Call this before the last GL context goes away if shaders must be freed deterministically.
+      The ActivityController calls this when it is destroyed.
+    */
+    static void clear() {
+      State& s = state();
+      std::lock_guard<std::mutex> lock(s.mutex);
+      s.programs.clear();
+    }
+  };
+}
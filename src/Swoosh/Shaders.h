@@ -1,6 +1,14 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "MeshCache.h"
+#include "ShaderCache.h"
+#include "SurfacePool.h"
 
 /*
 All of the pre-defined transition effects use common shaders
@@ -18,10 +26,10 @@ namespace swoosh {
     */
     class Shader {
     protected:
-      sf::Shader shader;
+      std::shared_ptr<sf::Shader> shader; //!< Shared with every instance compiled from the same source. See: ShaderCache
 
     public:
-      const sf::Shader& getShader() const { return shader; }
+      const sf::Shader& getShader() const { return *shader; }
       virtual ~Shader() { ; }
 
       virtual void apply(sf::RenderTexture& surface) = 0;
@@ -34,29 +42,29 @@ namespace swoosh {
     class FastGaussianBlur final : public Shader {
     private:
       std::string FAST_BLUR_SHADER;
-      sf::Texture* texture;
+      const sf::Texture* texture;
       float power;
+      sf::Color color;
     public:
-      void setPower(float power) { this->power = power; shader.setUniform("power", power); }
-
-      void setTexture(sf::Texture* tex) { 
-        if (!tex) return;
-
-        this->texture = tex; 
-
-        shader.setUniform("texture", *texture);
-        shader.setUniform("textureSizeW", (float)texture->getSize().x);
-        shader.setUniform("textureSizeH", (float)texture->getSize().y);
-      }
+      void setPower(float power) { this->power = power; }
+      void setColor(const sf::Color& color) { this->color = color; }
+      void setTexture(const sf::Texture* tex) { if (tex) this->texture = tex; }
 
       void apply(sf::RenderTexture& surface) override {
         if (!texture) return;
 
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("power", power);
+        shader->setUniform("texture", *texture);
+        shader->setUniform("textureSizeW", (float)texture->getSize().x);
+        shader->setUniform("textureSizeH", (float)texture->getSize().y);
+
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
 
         sf::Sprite sprite;
         sprite.setTexture(*texture);
+        sprite.setColor(color);
 
         surface.draw(sprite, states);
       }
@@ -64,6 +72,7 @@ namespace swoosh {
       FastGaussianBlur(int numOfKernels) {
         texture = nullptr;
         power = 0.0f;
+        color = sf::Color::White;
 
         this->FAST_BLUR_SHADER = GLSL
         (
@@ -113,7 +122,7 @@ namespace swoosh {
               }
             }
 
-            gl_FragColor = vec4(final_color / (Z*Z), 1.0);
+            gl_FragColor = vec4(final_color / (Z*Z), 1.0) * gl_Color;
           }
         );
 
@@ -123,17 +132,328 @@ namespace swoosh {
         size_t start_pos = this->FAST_BLUR_SHADER.find(from);
         if (start_pos != std::string::npos) {
           this->FAST_BLUR_SHADER.replace(start_pos, from.length(), to);
-          shader.loadFromMemory(this->FAST_BLUR_SHADER, sf::Shader::Fragment);
         }
         else {
           // should never happen
           assert(true && "could not find string %kernels% in guassian shader string");
         }
+
+        shader = ShaderCache::get(this->FAST_BLUR_SHADER);
       }
 
       ~FastGaussianBlur() { }
     };
 
+    /**
+      @class DownsampledBlur
+      @brief Multi-pass blur that works on a downsampled copy of the texture so its cost barely grows with radius
+
+      method::gaussian downsamples by 2, runs a horizontal and a vertical pass, and upsamples while drawing.
+      Each pass merges neighboring taps into one bilinear fetch so a kernel of `taps` texels costs taps/2 + 1 fetches.
+
+      method::dualKawase halves the texture `taps` times with 5 fetches per pass and doubles it back up with 8.
+      It is cheaper for very wide blurs but less faithful to a gaussian.
+
+      Intermediate targets are leased from the pool for the length of apply() and ping-ponged between passes.
+      If a target cannot be created the texture is drawn unblurred.
+    */
+    class DownsampledBlur final : public Shader {
+    public:
+      enum class method {
+        gaussian,
+        dualKawase
+      };
+
+    private:
+      std::string SEPARABLE_SHADER; //!< Gaussian pass with %fetches% standing in for the number of fetches
+      std::string_view KAWASE_DOWN_SHADER, KAWASE_UP_SHADER;
+      std::shared_ptr<sf::Shader> down; //!< Kawase downsample. Also downsamples for the gaussian.
+      SurfacePool& pool;
+      method mode;
+      int taps{}; //!< Kernel width in downsampled texels for gaussian. Number of halvings for dualKawase.
+      int fetches; //!< Bilinear fetches per side of a separable pass including the center
+      std::vector<float> weights, offsets; //!< Merged kernel uploaded every apply()
+      std::vector<SurfacePool::Lease> chain; //!< Targets leased during apply()
+      const sf::Texture* texture;
+      float power;
+      sf::Color color;
+
+      static constexpr unsigned scale = 2; //!< Gaussian downsample factor
+
+      /**
+        @brief Rebuilds the linear-sampled kernel for the current power
+
+        sigma matches FastGaussianBlur's 1 + power in full size pixels
+      */
+      void updateKernel() {
+        int radius = (taps - 1) / 2;
+        float sigma = std::max((1.0f + power) / static_cast<float>(scale), 0.1f);
+        std::vector<float> discrete(static_cast<std::size_t>(radius) + 2, 0.0f);
+        float total = 0.0f;
+
+        for (int i = 0; i <= radius; i++) {
+          discrete[i] = std::exp(-0.5f * i * i / (sigma * sigma));
+          total += i == 0 ? discrete[i] : 2.0f * discrete[i];
+        }
+
+        weights[0] = discrete[0] / total;
+        offsets[0] = 0.0f;
+
+        for (int k = 1; k < fetches; k++) {
+          int t1 = 2 * k - 1, t2 = 2 * k;
+          float w1 = discrete[t1], w2 = t2 <= radius ? discrete[t2] : 0.0f;
+          float w = w1 + w2;
+          weights[k] = w / total;
+          offsets[k] = w > 0.0f ? (t1 * w1 + t2 * w2) / w : 0.0f;
+        }
+      }
+
+      static void pass(sf::RenderTexture& target, const sf::Texture& source, sf::Shader* program, const sf::Color& tint = sf::Color::White, sf::BlendMode blend = sf::BlendNone) {
+        sf::Sprite sprite(source);
+        sf::Vector2u from = source.getSize();
+        sf::Vector2u to = target.getSize();
+        sprite.setScale(static_cast<float>(to.x) / from.x, static_cast<float>(to.y) / from.y);
+        sprite.setColor(tint);
+
+        sf::RenderStates states;
+        states.shader = program;
+        states.blendMode = blend;
+        target.draw(sprite, states);
+      }
+
+      /**
+        @brief Draws the finished blur over the full texture area of `surface` with the tint
+      */
+      void present(sf::RenderTexture& surface, const sf::Texture& blurred, sf::Shader* program) {
+        sf::Sprite sprite(blurred);
+        sf::Vector2u from = blurred.getSize();
+        sf::Vector2u to = texture->getSize();
+        sprite.setScale(static_cast<float>(to.x) / from.x, static_cast<float>(to.y) / from.y);
+        sprite.setColor(color);
+
+        sf::RenderStates states;
+        states.shader = program;
+        surface.draw(sprite, states);
+      }
+
+      sf::RenderTexture* lease(const sf::Vector2u& size) {
+        chain.emplace_back(pool.lease(sf::Vector2u(std::max(size.x, 1u), std::max(size.y, 1u))));
+
+        if (!chain.back()) return nullptr;
+
+        chain.back()->setSmooth(true);
+        return chain.back().get();
+      }
+
+      void downsample(sf::RenderTexture& target, const sf::Texture& source, float offset) {
+        sf::Vector2u size = source.getSize();
+        down->setUniform("texture", sf::Shader::CurrentTexture);
+        down->setUniform("halfpixel", sf::Vector2f(0.5f / size.x, 0.5f / size.y));
+        down->setUniform("offset", offset);
+        pass(target, source, down.get());
+        target.display();
+      }
+
+      void applyGaussian(sf::RenderTexture& surface) {
+        sf::Vector2u size = texture->getSize();
+        sf::Vector2u small(size.x / scale, size.y / scale);
+        sf::RenderTexture* ping = lease(small);
+        sf::RenderTexture* pong = lease(small);
+
+        if (!ping || !pong) {
+          present(surface, *texture, nullptr);
+          return;
+        }
+
+        small = ping->getSize();
+        updateKernel();
+
+        downsample(*ping, *texture, 1.0f);
+
+        shader->setUniform("texture", sf::Shader::CurrentTexture);
+        shader->setUniformArray("weights", weights.data(), weights.size());
+        shader->setUniformArray("offsets", offsets.data(), offsets.size());
+
+        shader->setUniform("direction", sf::Vector2f(1.0f / small.x, 0.0f));
+        pass(*pong, ping->getTexture(), shader.get());
+        pong->display();
+
+        shader->setUniform("direction", sf::Vector2f(0.0f, 1.0f / small.y));
+        pass(*ping, pong->getTexture(), shader.get());
+        ping->display();
+
+        present(surface, ping->getTexture(), nullptr);
+      }
+
+      void applyDualKawase(sf::RenderTexture& surface) {
+        float offset = 0.5f + power * 0.25f;
+        const sf::Texture* source = texture;
+        sf::Vector2u size = texture->getSize();
+
+        for (int i = 0; i < taps; i++) {
+          size = sf::Vector2u(size.x / 2, size.y / 2);
+          sf::RenderTexture* target = lease(size);
+
+          if (!target) {
+            present(surface, *texture, nullptr);
+            return;
+          }
+
+          downsample(*target, *source, offset);
+          source = &target->getTexture();
+        }
+
+        shader->setUniform("texture", sf::Shader::CurrentTexture);
+        shader->setUniform("offset", offset);
+
+        for (int i = taps - 1; i > 0; i--) {
+          sf::Vector2u from = chain[i]->getSize();
+          shader->setUniform("halfpixel", sf::Vector2f(0.5f / from.x, 0.5f / from.y));
+          pass(*chain[i - 1], chain[i]->getTexture(), shader.get());
+          chain[i - 1]->display();
+        }
+
+        sf::Vector2u from = chain[0]->getSize();
+        shader->setUniform("halfpixel", sf::Vector2f(0.5f / from.x, 0.5f / from.y));
+        present(surface, chain[0]->getTexture(), shader.get());
+      }
+
+    public:
+      void setPower(float power) { this->power = power; }
+      void setColor(const sf::Color& color) { this->color = color; }
+      void setTexture(const sf::Texture* tex) { if (tex) this->texture = tex; }
+
+      /**
+        @brief Changes the kernel width for gaussian or the number of halvings for dualKawase. Cheap if unchanged.
+
+        Each gaussian kernel width needs its own program. They are compiled once and shared. See: ShaderCache
+      */
+      void setTaps(int taps) {
+        taps = std::max(mode == method::gaussian ? (taps | 1) : taps, 1);
+
+        if (taps == this->taps) return;
+
+        this->taps = taps;
+        fetches = 1 + ((taps - 1) / 2 + 1) / 2; // the center plus one fetch per pair of texels
+        weights.resize(fetches);
+        offsets.resize(fetches);
+
+        if (mode != method::gaussian) return;
+
+        std::string source = SEPARABLE_SHADER;
+        std::string from("%fetches%");
+        std::string to = std::to_string(fetches);
+
+        for (size_t pos = source.find(from); pos != std::string::npos; pos = source.find(from, pos + to.length())) {
+          source.replace(pos, from.length(), to);
+        }
+
+        shader = ShaderCache::get(source);
+      }
+
+      const int getTaps() const { return taps; }
+
+      void apply(sf::RenderTexture& surface) override {
+        if (!texture) return;
+
+        if (mode == method::gaussian) {
+          applyGaussian(surface);
+        }
+        else {
+          applyDualKawase(surface);
+        }
+
+        chain.clear(); // return every target to the pool
+      }
+
+      /**
+        @param pool. Pool to lease intermediate targets from. Must outlive the blur.
+        @param mode. Blur method
+        @param taps. Odd kernel width in downsampled texels for gaussian e.g. 29. Number of halvings for dualKawase e.g. 4.
+      */
+      DownsampledBlur(SurfacePool& pool, method mode, int taps) : pool(pool), mode(mode) {
+        texture = nullptr;
+        power = 0.0f;
+        color = sf::Color::White;
+
+        KAWASE_DOWN_SHADER = GLSL
+        (
+          110,
+          uniform sampler2D texture;
+          uniform vec2 halfpixel;
+          uniform float offset;
+
+          void main()
+          {
+            vec2 uv = gl_TexCoord[0].xy;
+            vec4 sum = texture2D(texture, uv) * 4.0;
+            sum += texture2D(texture, uv - halfpixel * offset);
+            sum += texture2D(texture, uv + halfpixel * offset);
+            sum += texture2D(texture, uv + vec2(halfpixel.x, -halfpixel.y) * offset);
+            sum += texture2D(texture, uv - vec2(halfpixel.x, -halfpixel.y) * offset);
+            gl_FragColor = (sum / 8.0) * gl_Color;
+          }
+        );
+
+        down = ShaderCache::get(KAWASE_DOWN_SHADER);
+
+        if (mode == method::dualKawase) {
+          KAWASE_UP_SHADER = GLSL
+          (
+            110,
+            uniform sampler2D texture;
+            uniform vec2 halfpixel;
+            uniform float offset;
+
+            void main()
+            {
+              vec2 uv = gl_TexCoord[0].xy;
+              vec4 sum = texture2D(texture, uv + vec2(-halfpixel.x * 2.0, 0.0) * offset);
+              sum += texture2D(texture, uv + vec2(-halfpixel.x, halfpixel.y) * offset) * 2.0;
+              sum += texture2D(texture, uv + vec2(0.0, halfpixel.y * 2.0) * offset);
+              sum += texture2D(texture, uv + vec2(halfpixel.x, halfpixel.y) * offset) * 2.0;
+              sum += texture2D(texture, uv + vec2(halfpixel.x * 2.0, 0.0) * offset);
+              sum += texture2D(texture, uv + vec2(halfpixel.x, -halfpixel.y) * offset) * 2.0;
+              sum += texture2D(texture, uv + vec2(0.0, -halfpixel.y * 2.0) * offset);
+              sum += texture2D(texture, uv + vec2(-halfpixel.x, -halfpixel.y) * offset) * 2.0;
+              gl_FragColor = vec4((sum / 12.0).rgb, 1.0) * gl_Color;
+            }
+          );
+
+          shader = ShaderCache::get(KAWASE_UP_SHADER);
+          setTaps(taps);
+          return;
+        }
+
+        this->SEPARABLE_SHADER = GLSL
+        (
+          110,
+          uniform sampler2D texture;
+          uniform vec2 direction;
+          uniform float weights[%fetches%];
+          uniform float offsets[%fetches%];
+
+          void main()
+          {
+            vec2 uv = gl_TexCoord[0].xy;
+            vec3 sum = texture2D(texture, uv).rgb * weights[0];
+
+            for (int i = 1; i < %fetches%; ++i)
+            {
+              sum += texture2D(texture, uv + direction * offsets[i]).rgb * weights[i];
+              sum += texture2D(texture, uv - direction * offsets[i]).rgb * weights[i];
+            }
+
+            gl_FragColor = vec4(sum, 1.0) * gl_Color;
+          }
+        );
+
+        setTaps(taps);
+      }
+
+      ~DownsampledBlur() { }
+    };
+
     /**
       @class Checkerboard
       @brief Blocks out texture1 with pieces of texture2 defined by the cols x rows grid over time.
@@ -142,25 +462,33 @@ namespace swoosh {
     */
     class Checkerboard final : public Shader {
     private:
-      std::string CHECKERBOARD_SHADER;
+      std::string_view CHECKERBOARD_SHADER;
       float alpha;
       int cols, rows;
       float smoothness;
-      sf::Texture *texture1, *texture2;
+      const sf::Texture *texture1, *texture2;
 
     public:
-      void setAlpha(float alpha) { this->alpha = alpha; shader.setUniform("progress", (float)alpha); }
-      void setCols(int cols) { this->cols = cols;       shader.setUniform("cols", cols); }
-      void setRows(int rows) { this->rows = rows;       shader.setUniform("rows", rows); }
-      void setSmoothness(float smoothness) { this->smoothness = smoothness;         shader.setUniform("smoothness", smoothness);  }
-      void setTexture1(sf::Texture* tex) { if (!tex) return;  this->texture1 = tex; shader.setUniform("texture",  *texture1); }
-      void setTexture2(sf::Texture* tex) { if (!tex) return;  this->texture2 = tex; shader.setUniform("texture2", *texture2); }
+      void setAlpha(float alpha) { this->alpha = alpha; }
+      void setCols(int cols) { this->cols = cols; }
+      void setRows(int rows) { this->rows = rows; }
+      void setSmoothness(float smoothness) { this->smoothness = smoothness; }
+      void setTexture1(const sf::Texture* tex) { if (tex) this->texture1 = tex; }
+      void setTexture2(const sf::Texture* tex) { if (tex) this->texture2 = tex; }
 
       void apply(sf::RenderTexture& surface) override {
         if (!(texture1 && texture2)) return;
 
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("progress", alpha);
+        shader->setUniform("cols", cols);
+        shader->setUniform("rows", rows);
+        shader->setUniform("smoothness", smoothness);
+        shader->setUniform("texture", *texture1);
+        shader->setUniform("texture2", *texture2);
+
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
 
         sf::Sprite sprite;
         sprite.setTexture(*texture1);
@@ -197,7 +525,7 @@ namespace swoosh {
           }
         );
 
-        shader.loadFromMemory(this->CHECKERBOARD_SHADER, sf::Shader::Fragment);
+        shader = ShaderCache::get(this->CHECKERBOARD_SHADER);
       }
 
       ~Checkerboard() { ; }
@@ -209,21 +537,26 @@ namespace swoosh {
     */
     class CircleMask final : public Shader {
     private:
-      std::string CIRCLE_MASK_SHADER;
-      sf::Texture* texture;
+      std::string_view CIRCLE_MASK_SHADER;
+      const sf::Texture* texture;
       float alpha; 
       float aspectRatio;
 
     public:
-      void setAlpha(float alpha) { this->alpha = alpha; shader.setUniform("time", (float)alpha); }
-      void setAspectRatio(float aspectRatio) { this->aspectRatio = aspectRatio;  shader.setUniform("ratio", aspectRatio); }
-      void setTexture(sf::Texture* tex) { if (!tex) return; this->texture = tex; shader.setUniform("texture", *texture); }
+      void setAlpha(float alpha) { this->alpha = alpha; }
+      void setAspectRatio(float aspectRatio) { this->aspectRatio = aspectRatio; }
+      void setTexture(const sf::Texture* tex) { if (tex) this->texture = tex; }
 
       void apply(sf::RenderTexture& surface) override {
         if (!texture) return;
 
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("time", alpha);
+        shader->setUniform("ratio", aspectRatio);
+        shader->setUniform("texture", *texture);
+
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
 
         sf::Sprite sprite;
         sprite.setTexture(*texture);
@@ -265,7 +598,8 @@ namespace swoosh {
 
         texture = nullptr;
         alpha = 0;
-        shader.loadFromMemory(this->CIRCLE_MASK_SHADER, sf::Shader::Fragment);
+        aspectRatio = 1.0f;
+        shader = ShaderCache::get(this->CIRCLE_MASK_SHADER);
       }
 
       ~CircleMask() { ; }
@@ -277,22 +611,28 @@ namespace swoosh {
     */
     class RetroBlit final : public Shader {
     private:
-      std::string RETRO_BLIT_SHADER;
+      std::string_view RETRO_BLIT_SHADER;
       int kernelCols, kernelRows;
       float alpha;
-      sf::Texture* texture;
+      const sf::Texture* texture;
 
     public:
-      void setTexture(sf::Texture* tex) { if (!tex) return; texture = tex; shader.setUniform("texture", *texture); }
-      void setAlpha(float alpha) { this->alpha = alpha; shader.setUniform("progress", alpha); }
-      void setKernelCols(int kcols) { this->kernelCols = kcols; shader.setUniform("cols", kernelCols); }
-      void setKernelRows(int krows) { this->kernelRows = krows; shader.setUniform("rows", kernelRows); }
+      void setTexture(const sf::Texture* tex) { if (tex) this->texture = tex; }
+      void setAlpha(float alpha) { this->alpha = alpha; }
+      void setKernelCols(int kcols) { this->kernelCols = kcols; }
+      void setKernelRows(int krows) { this->kernelRows = krows; }
 
       void apply(sf::RenderTexture& surface) override {
         if (!texture) return;
 
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("progress", alpha);
+        shader->setUniform("cols", kernelCols);
+        shader->setUniform("rows", kernelRows);
+        shader->setUniform("texture", *texture);
+
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
 
         sf::Sprite sprite;
         sprite.setTexture(*texture);
@@ -322,7 +662,7 @@ namespace swoosh {
           }
         );
 
-        shader.loadFromMemory(this->RETRO_BLIT_SHADER, sf::Shader::Fragment);
+        shader = ShaderCache::get(this->RETRO_BLIT_SHADER);
 
         kernelCols = kcols;
         kernelRows = krows;
@@ -340,22 +680,28 @@ namespace swoosh {
     */
     class CrossZoom final : public Shader {
     private:
-      std::string CROSS_ZOOM_SHADER;
-      sf::Texture* texture1, *texture2;
+      std::string_view CROSS_ZOOM_SHADER;
+      const sf::Texture* texture1, *texture2;
       float power;
       float alpha;
 
     public:
-      void setTexture1(sf::Texture* tex) { if (!tex) return; texture1 = tex; shader.setUniform("texture", *texture1); }
-      void setTexture2(sf::Texture* tex) { if (!tex) return; texture2 = tex; shader.setUniform("texture2", *texture2); }
-      void setAlpha(float alpha) { this->alpha = alpha; shader.setUniform("progress", (float)alpha); }
-      void setPower(float power) { this->power = power; shader.setUniform("strength", power); }
+      void setTexture1(const sf::Texture* tex) { if (tex) this->texture1 = tex; }
+      void setTexture2(const sf::Texture* tex) { if (tex) this->texture2 = tex; }
+      void setAlpha(float alpha) { this->alpha = alpha; }
+      void setPower(float power) { this->power = power; }
 
       void apply(sf::RenderTexture& surface) override {
         if (!(texture1 && texture2)) return;
 
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("progress", alpha);
+        shader->setUniform("strength", power);
+        shader->setUniform("texture", *texture1);
+        shader->setUniform("texture2", *texture2);
+
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
 
         sf::Sprite sprite;
         sprite.setTexture(*texture1);
@@ -365,7 +711,7 @@ namespace swoosh {
 
       CrossZoom() {
         texture1 = texture2 = nullptr;
-        alpha = 0;
+        alpha = power = 0;
 
         // Modified by TheMaverickProgrammer slightly to support GLSL 1.10
         this->CROSS_ZOOM_SHADER = GLSL(
@@ -443,7 +789,7 @@ namespace swoosh {
             }
         );
 
-        shader.loadFromMemory(this->CROSS_ZOOM_SHADER, sf::Shader::Fragment);
+        shader = ShaderCache::get(this->CROSS_ZOOM_SHADER);
       }
 
       ~CrossZoom() { }
@@ -455,22 +801,28 @@ namespace swoosh {
     */
     class Morph final : public Shader {
     private:
-      std::string MORPH_SHADER;
-      sf::Texture* texture1, *texture2;
+      std::string_view MORPH_SHADER;
+      const sf::Texture* texture1, *texture2;
       float strength;
       float alpha;
     public:
 
-      void setTexture1(sf::Texture* tex) { if (!tex) return; texture1 = tex; shader.setUniform("texture", *texture1); }
-      void setTexture2(sf::Texture* tex) { if (!tex) return; texture2 = tex; shader.setUniform("texture2", *texture2); }
-      void setAlpha(float alpha) { this->alpha = alpha; shader.setUniform("alpha", (float)alpha); }
-      void setStrength(float strength) { this->strength = strength; shader.setUniform("strength", strength); }
+      void setTexture1(const sf::Texture* tex) { if (tex) this->texture1 = tex; }
+      void setTexture2(const sf::Texture* tex) { if (tex) this->texture2 = tex; }
+      void setAlpha(float alpha) { this->alpha = alpha; }
+      void setStrength(float strength) { this->strength = strength; }
 
       void apply(sf::RenderTexture& surface) override {
         if (!(texture1 && texture2)) return;
 
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("alpha", alpha);
+        shader->setUniform("strength", strength);
+        shader->setUniform("texture", *texture1);
+        shader->setUniform("texture2", *texture2);
+
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
 
         sf::Sprite sprite;
         sprite.setTexture(*texture1);
@@ -503,7 +855,7 @@ namespace swoosh {
           }
         );
 
-        shader.loadFromMemory(this->MORPH_SHADER, sf::Shader::Fragment);
+        shader = ShaderCache::get(this->MORPH_SHADER);
 
         texture1 = texture2 = nullptr;
         alpha = strength = 0;
@@ -531,69 +883,24 @@ namespace swoosh {
     */
     class PageTurn final : public Shader {
     private:
-      sf::Texture* texture;
+      const sf::Texture* texture;
       sf::Vector2u size;
       float alpha;
 
-      std::string TURN_PAGE_VERT_SHADER, TURN_PAGE_FRAG_SHADER;
-      sf::VertexArray buffer;
+      std::string_view TURN_PAGE_VERT_SHADER, TURN_PAGE_FRAG_SHADER;
 
-      // More cells means higher quality effect at the cost of more work for cpu and gpu
+      // More cells means higher quality effect at the cost of more work for the gpu
       // Bigger cell size = less cells fit, less smooth, higher performance
       // Smaller cell size = more cells fit, smooth, slower performance
-      void triangleStripulate(int screenWidth, int screenHeight, sf::VertexArray& destination, int cellSize) {
-        destination.clear();
-
-        int cols = screenWidth / cellSize;
-        int rows = screenHeight / cellSize;
-
-        // each grid has 2 triangles which have 3 points (1 point = 1 vertex)
-        int total = cols * rows * 2 * 3;
-        destination = sf::VertexArray(sf::PrimitiveType::Triangles, total);
-
-        int index = 0;
-        for (int i = 0; i < cols; i++) {
-          for (int j = 0; j < rows; j++) {
-            sf::Vertex vertex;
-            vertex.color = sf::Color::White;
-
-            sf::Vector2f pos[4] = {
-              sf::Vector2f((float)i*cellSize      , (float)j*cellSize),
-              sf::Vector2f((float)i*cellSize      , (float)(j + 1)*cellSize),
-              sf::Vector2f((float)(i + 1)*cellSize, (float)(j + 1)*cellSize),
-              sf::Vector2f((float)(i + 1)*cellSize, (float)j*cellSize)
-            };
-
-
-            sf::Vector2f tex[4] = {
-              sf::Vector2f((i*cellSize) / (float)screenWidth, (j*cellSize) / (float)screenHeight),
-              sf::Vector2f((i*cellSize) / (float)screenWidth, ((j + 1)*cellSize) / (float)screenHeight),
-              sf::Vector2f(((i + 1)*cellSize) / (float)screenWidth, ((j + 1)*cellSize) / (float)screenHeight),
-              sf::Vector2f(((i + 1)*cellSize) / (float)screenWidth, (j*cellSize) / (float)screenHeight)
-            };
-
-            // ccw
-            int order[6] = { 0, 2, 1, 0, 3, 2 };
-
-            for (auto o : order) {
-              vertex.position = pos[o];
-              vertex.texCoords = tex[o];
-              destination[index++] = vertex;
-            }
-          }
-        }
-
-        destination[0].color = sf::Color::Blue;
-        destination[(((cols - 1) * (rows)) * 6) + 5].color = sf::Color::Green;
-        destination[total - 1].color = sf::Color::Red;
-      }
+      std::shared_ptr<const MeshCache::Grid> grid; //!< Shared by every PageTurn with the same size and cell size
 
     public:
 
-      void setTexture(sf::Texture* tex) { if (!tex) return;  this->texture = tex; shader.setUniform("texture", *texture); }
+      void setTexture(const sf::Texture* tex) { if (tex) this->texture = tex; }
+      void setAlpha(float alpha) { this->alpha = alpha; }
 
-      void setAlpha(float alpha) {
-        this->alpha = alpha; 
+      void apply(sf::RenderTexture& surface) override {
+        if (!(this->texture)) return;
 
         /*
         these are hard-coded values that make the effect look natural
@@ -624,19 +931,25 @@ namespace swoosh {
         theta = ease::interpolate(dt, angle1, angle2);
         A = ease::interpolate(dt, A1, A2);
 
-        shader.setUniform("A", (float)A);
-        shader.setUniform("theta", (float)theta);
-        shader.setUniform("rho", (float)rho);
-      }
-
-      void apply(sf::RenderTexture& surface) override {
-        if (!(this->texture)) return;
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("A", (float)A);
+        shader->setUniform("theta", (float)theta);
+        shader->setUniform("rho", (float)rho);
+        shader->setUniform("texture", *texture);
 
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
+
+        grid->draw(surface, states);
+      }
+
+      /**
+        @brief Switches to the shared grid with cells of `cellSize` pixels. Cheap if unchanged.
+      */
+      void setCellSize(int cellSize) {
+        if (grid && grid->getCellSize() == std::max(cellSize, 1)) return;
 
-        surface.clear(sf::Color::Transparent);
-        surface.draw(buffer, states);
+        grid = MeshCache::grid(size, cellSize);
       }
 
       PageTurn(sf::Vector2u size, const int cellSize = 10) {
@@ -693,8 +1006,8 @@ namespace swoosh {
           }
         );
 
-        shader.loadFromMemory(this->TURN_PAGE_VERT_SHADER, this->TURN_PAGE_FRAG_SHADER);
-        triangleStripulate((int)size.x, (int)size.y, buffer, cellSize);
+        shader = ShaderCache::get(this->TURN_PAGE_VERT_SHADER, this->TURN_PAGE_FRAG_SHADER);
+        setCellSize(cellSize);
       }
 
       ~PageTurn() {}
@@ -706,16 +1019,20 @@ namespace swoosh {
     */
     class Pixelate final : public Shader {
     private:
-      std::string PIXELATE_SHADER;
-      sf::Texture* texture;
+      std::string_view PIXELATE_SHADER;
+      const sf::Texture* texture;
       float threshold;
 
     public:
       void apply(sf::RenderTexture& surface) override {
         if (!this->texture) return;
-        
+
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("pixel_threshold", threshold);
+        shader->setUniform("texture", *this->texture);
+
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
 
         sf::Sprite sprite;
         sprite.setTexture(*this->texture);
@@ -723,8 +1040,8 @@ namespace swoosh {
         surface.draw(sprite, states);
       }
 
-      void setTexture(sf::Texture* tex) { if (!tex) return; this->texture = tex; shader.setUniform("texture", *this->texture); }
-      void setThreshold(float t) { this->threshold = t; shader.setUniform("pixel_threshold", threshold); }
+      void setTexture(const sf::Texture* tex) { if (tex) this->texture = tex; }
+      void setThreshold(float t) { this->threshold = t; }
 
       Pixelate() {
         threshold = 0;
@@ -743,7 +1060,7 @@ namespace swoosh {
           }
         );
 
-        shader.loadFromMemory(this->PIXELATE_SHADER, sf::Shader::Fragment);
+        shader = ShaderCache::get(this->PIXELATE_SHADER);
       }
 
       ~Pixelate() {}
@@ -755,17 +1072,22 @@ namespace swoosh {
     */
     class RadialCCW final : public Shader {
     private:
-      std::string RADIAL_CCW_SHADER;
-      sf::Texture* texture1;
-      sf::Texture* texture2;
+      std::string_view RADIAL_CCW_SHADER;
+      const sf::Texture* texture1;
+      const sf::Texture* texture2;
       float alpha;
 
     public:
       void apply(sf::RenderTexture& surface) override {
         if (!(this->texture1 && this->texture2)) return;
 
+        // The program is shared with other instances. See: ShaderCache
+        shader->setUniform("time", alpha);
+        shader->setUniform("texture", *texture1);
+        shader->setUniform("texture2", *texture2);
+
         sf::RenderStates states;
-        states.shader = &shader;
+        states.shader = shader.get();
 
         sf::Sprite sprite;
         sprite.setTexture(*texture1);
@@ -773,9 +1095,9 @@ namespace swoosh {
         surface.draw(sprite, states);
       }
 
-      void setTexture1(sf::Texture* tex) { if (!tex) return; this->texture1 = tex; shader.setUniform("texture", *texture1); }
-      void setTexture2(sf::Texture* tex) { if (!tex) return; this->texture2 = tex; shader.setUniform("texture2", *texture2);}
-      void setAlpha(float alpha) { this->alpha = alpha; shader.setUniform("time", (float)alpha); }
+      void setTexture1(const sf::Texture* tex) { if (tex) this->texture1 = tex; }
+      void setTexture2(const sf::Texture* tex) { if (tex) this->texture2 = tex; }
+      void setAlpha(float alpha) { this->alpha = alpha; }
 
       RadialCCW() {
         alpha = 0;
@@ -801,7 +1123,7 @@ namespace swoosh {
           }
         );
 
-        shader.loadFromMemory(this->RADIAL_CCW_SHADER, sf::Shader::Fragment);
+        shader = ShaderCache::get(this->RADIAL_CCW_SHADER);
       }
 
       ~RadialCCW() { ; }
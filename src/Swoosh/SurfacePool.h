@@ -0,0 +1,169 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <cstddef>
+
+namespace swoosh {
+  /**
+    @class SurfacePool
+    @brief Recycles render textures so multi-pass effects do not allocate GPU memory every frame
+
+    Surfaces are keyed by their size and context settings. Leasing a surface hands out an idle match
+    if one exists (a hit) or creates a new one (a miss). When the lease ends the surface goes back to the pool.
+
+    @warning The pool must outlive every lease it hands out
+  */
+  class SurfacePool {
+  public:
+    /**
+      @class Stats
+      @brief Counters describing how well the pool is reused
+    */
+    struct Stats {
+      std::size_t hits{};          //!< Leases satisfied by an idle surface
+      std::size_t misses{};        //!< Leases that had to create a new surface
+      std::size_t leased{};        //!< Surfaces currently out on lease
+      std::size_t idle{};          //!< Surfaces waiting in the pool
+      std::size_t bytesResident{}; //!< Estimated GPU memory of every surface the pool owns (leased + idle)
+    };
+
+  private:
+    using Key = std::tuple<unsigned int, unsigned int, unsigned int, unsigned int, unsigned int>;
+
+    std::multimap<Key, std::unique_ptr<sf::RenderTexture>> surfaces; //!< Idle surfaces
+    Stats stats; //!< Reuse statistics
+
+    static Key makeKey(const sf::Vector2u& size, const sf::ContextSettings& settings) {
+      return Key{ size.x, size.y, settings.depthBits, settings.stencilBits, settings.antialiasingLevel };
+    }
+
+    static std::size_t bytesOf(const sf::Vector2u& size) {
+      return static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4u; // RGBA8
+    }
+
+  public:
+    /**
+      @class Lease
+      @brief RAII handle to a pooled render texture. The surface returns to the pool when the lease is destroyed.
+    */
+    class Lease {
+      friend class SurfacePool;
+
+    private:
+      SurfacePool* pool{ nullptr };
+      Key key;
+      std::unique_ptr<sf::RenderTexture> surface;
+
+      Lease(SurfacePool* pool, const Key& key, std::unique_ptr<sf::RenderTexture> surface)
+        : pool(pool), key(key), surface(std::move(surface)) { }
+
+    public:
+      Lease() = default;
+      Lease(const Lease& rhs) = delete;
+      Lease& operator=(const Lease& rhs) = delete;
+
+      Lease(Lease&& rhs) noexcept : pool(rhs.pool), key(rhs.key), surface(std::move(rhs.surface)) {
+        rhs.pool = nullptr;
+      }
+
+      Lease& operator=(Lease&& rhs) noexcept {
+        if (this != &rhs) {
+          release();
+          pool = rhs.pool;
+          key = rhs.key;
+          surface = std::move(rhs.surface);
+          rhs.pool = nullptr;
+        }
+
+        return *this;
+      }
+
+      ~Lease() { release(); }
+
+      /**
+        @brief Returns the surface to the pool early. The lease is empty afterwards.
+      */
+      void release() {
+        if (pool && surface) {
+          pool->giveBack(key, std::move(surface));
+        }
+
+        pool = nullptr;
+      }
+
+      sf::RenderTexture* get() const { return surface.get(); }
+      sf::RenderTexture& operator*() const { return *surface; }
+      sf::RenderTexture* operator->() const { return surface.get(); }
+      explicit operator bool() const { return surface != nullptr; }
+    };
+
+    SurfacePool() = default;
+    SurfacePool(const SurfacePool& rhs) = delete;
+    SurfacePool& operator=(const SurfacePool& rhs) = delete;
+    ~SurfacePool() = default;
+
+    /**
+      @brief Lease a render texture with the given size and context settings
+      @return a lease that owns the surface until it goes out of scope. Empty if the surface could not be created.
+
+      The surface's view is reset to its default view. Its contents are undefined and should be cleared before use.
+    */
+    Lease lease(const sf::Vector2u& size, const sf::ContextSettings& settings = sf::ContextSettings()) {
+      Key key = makeKey(size, settings);
+      std::unique_ptr<sf::RenderTexture> surface;
+
+      auto iter = surfaces.find(key);
+
+      if (iter != surfaces.end()) {
+        surface = std::move(iter->second);
+        surfaces.erase(iter);
+        stats.idle--;
+        stats.hits++;
+      }
+      else {
+        surface = std::make_unique<sf::RenderTexture>();
+
+        if (!surface->create(size.x, size.y, settings)) {
+          return Lease();
+        }
+
+        stats.bytesResident += bytesOf(size);
+        stats.misses++;
+      }
+
+      surface->setView(surface->getDefaultView());
+      surface->setSmooth(false);
+      stats.leased++;
+
+      return Lease(this, key, std::move(surface));
+    }
+
+    /**
+      @brief Frees every idle surface. Surfaces out on lease are not affected.
+    */
+    void trim() {
+      for (auto& [key, surface] : surfaces) {
+        stats.bytesResident -= bytesOf(sf::Vector2u(std::get<0>(key), std::get<1>(key)));
+      }
+
+      surfaces.clear();
+      stats.idle = 0;
+    }
+
+    /**
+      @brief Query the pool's reuse statistics
+    */
+    const Stats& getStats() const {
+      return stats;
+    }
+
+  private:
+    void giveBack(const Key& key, std::unique_ptr<sf::RenderTexture> surface) {
+      surfaces.emplace(key, std::move(surface));
+      stats.leased--;
+      stats.idle++;
+    }
+  };
+}
@@ -0,0 +1,395 @@
+#pragma once
+
+/**
+ * Coroutine tasks need C++20. The header is empty in C++17 builds and SWOOSH_HAS_COROUTINES stays undefined.
+ */
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define SWOOSH_HAS_COROUTINES 1
+
+#include "Activity.h"
+#include "ActionList.h"
+#include "TimerService.h"
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace swoosh {
+  class TaskScheduler;
+
+  /**
+    @class Task
+    @brief A coroutine an activity can run over many frames instead of writing a state machine
+
+    e.g.
+      swoosh::Task intro() {
+        co_await swoosh::wait(sf::milliseconds(500));
+        showTitle();
+        getController().push<segue<BlackWashFade>::to<GameplayScene>>();
+        co_await swoosh::segueFinished();
+      }
+
+      void onStart() override { getController().getTasks().start(this, intro()); }
+
+    Tasks start suspended and run once handed to the TaskScheduler. Coroutines that are member functions
+    of an activity allocate their frame from that activity's arena. Others use the heap.
+  */
+  class Task {
+  public:
+    struct promise_type {
+      TaskScheduler* scheduler{ nullptr };
+      const Activity* owner{ nullptr };
+      std::list<std::coroutine_handle<promise_type>>::iterator position; //!< Where the scheduler keeps this task
+      TimerService::Handle timer; //!< Set while waiting on wait()
+      std::exception_ptr error;
+
+      Task get_return_object() {
+        return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; } // the scheduler destroys finished tasks
+      void return_void() { }
+      void unhandled_exception() { error = std::current_exception(); }
+
+      /**
+        @brief Frames of activity member coroutines come from the activity's arena
+      */
+      template<typename Self, typename... Args, std::enable_if_t<std::is_base_of<Activity, Self>::value, int> = 0>
+      static void* operator new(std::size_t bytes, Self& self, Args&...) {
+        return allocate(bytes, self.getController().getTasks().arenaFor(&self));
+      }
+
+      static void* operator new(std::size_t bytes) {
+        return allocate(bytes, nullptr);
+      }
+
+      static void operator delete(void* frame, std::size_t bytes) {
+        Header* header = reinterpret_cast<Header*>(static_cast<unsigned char*>(frame) - headerSize);
+        std::shared_ptr<ActionArena> arena = std::move(header->arena);
+        std::size_t total = header->total;
+        header->~Header();
+
+        if (arena) {
+          arena->deallocate(header, total);
+        }
+        else {
+          ::operator delete(header);
+        }
+      }
+
+    private:
+      /**
+        @brief Kept in front of every frame so it can be returned to where it came from
+      */
+      struct Header {
+        std::shared_ptr<ActionArena> arena; //!< Keeps the arena alive for frames that outlive their activity
+        std::size_t total{};
+      };
+
+      static constexpr std::size_t headerSize = (sizeof(Header) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+      static void* allocate(std::size_t bytes, std::shared_ptr<ActionArena> arena) {
+        std::size_t total = headerSize + bytes;
+
+        if (arena && !ActionArena::fits(total, alignof(std::max_align_t))) {
+          arena = nullptr; // too large for a block
+        }
+
+        void* memory = arena ? arena->allocate(total) : ::operator new(total);
+        new (memory) Header{ std::move(arena), total };
+        return static_cast<unsigned char*>(memory) + headerSize;
+      }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+  private:
+    friend class TaskScheduler;
+    Handle handle;
+
+    explicit Task(Handle handle) : handle(handle) { }
+
+  public:
+    Task(Task&& rhs) noexcept : handle(std::exchange(rhs.handle, nullptr)) { }
+
+    Task& operator=(Task&& rhs) noexcept {
+      if (this != &rhs) {
+        if (handle) handle.destroy();
+        handle = std::exchange(rhs.handle, nullptr);
+      }
+
+      return *this;
+    }
+
+    Task(const Task& rhs) = delete;
+    Task& operator=(const Task& rhs) = delete;
+
+    ~Task() {
+      // Never started
+      if (handle) handle.destroy();
+    }
+  };
+
+  /**
+    @class TaskScheduler
+    @brief Resumes the coroutine tasks of every activity from the ActivityController's update loop
+
+    Like the TimerService, tasks owned by an activity only run while that activity is on top of the stack
+    and are destroyed when the activity is deleted. Tasks owned by no one (nullptr) always run.
+
+    This is owned by the ActivityController. See: ActivityController::getTasks()
+  */
+  class TaskScheduler {
+    friend struct Task::promise_type;
+    friend struct WaitAwaiter;
+    friend struct FrameAwaiter;
+    friend struct SegueAwaiter;
+
+  private:
+    TimerService& timers;
+    std::list<Task::Handle> tasks; //!< Every started task
+    std::vector<Task::Handle> frameQueue; //!< Tasks waiting for the next frame
+    std::deque<Task::Handle> resuming; //!< Tasks being resumed this update
+    std::vector<Task::Handle> segueQueue; //!< Tasks waiting for a segue to finish
+    std::unordered_map<const Activity*, std::shared_ptr<ActionArena>> arenas;
+    const Activity* focused{ nullptr };
+    Task::Handle running{ nullptr }; //!< Task being resumed right now
+    bool killRunning{ false }; //!< The running task was released and is destroyed once it suspends
+
+    /**
+      @brief Returns the frame arena of the activity. Created the first time one of its coroutines is called.
+    */
+    std::shared_ptr<ActionArena> arenaFor(const Activity* owner) {
+      std::shared_ptr<ActionArena>& arena = arenas[owner];
+
+      if (!arena) {
+        arena = std::make_shared<ActionArena>();
+      }
+
+      return arena;
+    }
+
+    template<typename Queue>
+    static void forget(Queue& queue, Task::Handle handle) {
+      queue.erase(std::remove(queue.begin(), queue.end(), handle), queue.end());
+    }
+
+    void destroy(Task::Handle handle) {
+      timers.cancel(handle.promise().timer);
+      forget(frameQueue, handle);
+      forget(resuming, handle);
+      forget(segueQueue, handle);
+      tasks.erase(handle.promise().position);
+      handle.destroy();
+    }
+
+    /**
+      @brief Runs the task until it suspends again. Finished tasks are destroyed.
+      @throws the exception the task ended with
+    */
+    void resume(Task::Handle handle) {
+      Task::Handle outer = std::exchange(running, handle);
+      bool outerKilled = std::exchange(killRunning, false);
+
+      handle.resume();
+
+      bool killed = killRunning;
+      running = outer;
+      killRunning = outerKilled;
+
+      if (handle.done() || killed) {
+        std::exception_ptr error = handle.promise().error;
+        destroy(handle);
+
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+
+    bool isAwake(const Activity* owner) const {
+      return owner == nullptr || owner == focused;
+    }
+
+  public:
+    TaskScheduler(TimerService& timers) : timers(timers) { }
+
+    TaskScheduler(const TaskScheduler& rhs) = delete;
+    TaskScheduler& operator=(const TaskScheduler& rhs) = delete;
+
+    ~TaskScheduler() {
+      clear();
+    }
+
+    /**
+      @brief Hands the task to the scheduler. It first runs on the next update.
+      @param owner. The activity the task belongs to. May be nullptr.
+      @param task. A task that has not started yet
+    */
+    void start(const Activity* owner, Task task) {
+      if (!task.handle) return;
+
+      Task::Handle handle = std::exchange(task.handle, nullptr);
+      Task::promise_type& promise = handle.promise();
+      promise.scheduler = this;
+      promise.owner = owner;
+      promise.position = tasks.insert(tasks.end(), handle);
+      frameQueue.push_back(handle);
+    }
+
+    /**
+      @brief Destroys every task the owner has and frees its frame arena. Safe to call from inside a task.
+    */
+    void release(const Activity* owner) {
+      for (auto iter = tasks.begin(); iter != tasks.end();) {
+        Task::Handle handle = *iter++;
+
+        if (handle.promise().owner != owner) continue;
+
+        if (handle == running) {
+          killRunning = true; // destroyed once it suspends
+          continue;
+        }
+
+        destroy(handle);
+      }
+
+      arenas.erase(owner);
+    }
+
+    /**
+      @brief Destroys every task and frees every frame arena
+    */
+    void clear() {
+      while (!tasks.empty()) {
+        destroy(tasks.front());
+      }
+
+      arenas.clear();
+    }
+
+    /**
+      @brief Tasks of the activity on top run. Tasks of every other activity wait.
+
+      This is used internally by the ActivityController every step
+    */
+    void focus(const Activity* top) {
+      focused = top;
+    }
+
+    /**
+      @brief Resumes the tasks waiting for the next frame
+
+      This is used internally by the ActivityController every step
+    */
+    void update() {
+      resuming.assign(frameQueue.begin(), frameQueue.end());
+      frameQueue.clear();
+
+      // Tasks resumed here that wait for a frame again are queued for the next update
+      while (!resuming.empty()) {
+        Task::Handle handle = resuming.front();
+        resuming.pop_front();
+
+        if (!isAwake(handle.promise().owner)) {
+          frameQueue.push_back(handle);
+          continue;
+        }
+
+        resume(handle);
+      }
+    }
+
+    /**
+      @brief Resumes the tasks waiting for a segue to finish
+
+      This is used internally by the ActivityController when a segue ends
+    */
+    void segueFinished() {
+      std::vector<Task::Handle> waiting;
+      std::swap(waiting, segueQueue);
+
+      for (Task::Handle handle : waiting) {
+        // may have been released by a task resumed before it
+        if (std::find(tasks.begin(), tasks.end(), handle) == tasks.end()) continue;
+
+        resume(handle);
+      }
+    }
+
+    /**
+      @brief Query the number of started tasks that have not finished
+    */
+    const std::size_t size() const {
+      return tasks.size();
+    }
+  };
+
+  /**
+    @brief Awaitable returned by swoosh::wait()
+  */
+  struct WaitAwaiter {
+    sf::Time delay;
+
+    bool await_ready() const noexcept { return delay <= sf::Time::Zero; }
+
+    void await_suspend(Task::Handle handle) {
+      Task::promise_type& promise = handle.promise();
+      TaskScheduler* scheduler = promise.scheduler;
+      promise.timer = scheduler->timers.after(promise.owner, delay, [scheduler, handle] { scheduler->resume(handle); });
+    }
+
+    void await_resume() const noexcept { }
+  };
+
+  /**
+    @brief Awaitable returned by swoosh::nextFrame()
+  */
+  struct FrameAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Task::Handle handle) { handle.promise().scheduler->frameQueue.push_back(handle); }
+    void await_resume() const noexcept { }
+  };
+
+  /**
+    @brief Awaitable returned by swoosh::segueFinished()
+  */
+  struct SegueAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Task::Handle handle) { handle.promise().scheduler->segueQueue.push_back(handle); }
+    void await_resume() const noexcept { }
+  };
+
+  /**
+    @brief Suspends the task for `delay`. Counts down on the TimerService so it pauses with its activity.
+  */
+  inline WaitAwaiter wait(sf::Time delay) {
+    return WaitAwaiter{ delay };
+  }
+
+  /**
+    @brief Suspends the task until the next update
+  */
+  inline FrameAwaiter nextFrame() {
+    return FrameAwaiter{};
+  }
+
+  /**
+    @brief Suspends the task until the next segue finishes e.g. right after pushing or popping with a segue
+  */
+  inline SegueAwaiter segueFinished() {
+    return SegueAwaiter{};
+  }
+}
+
+#endif
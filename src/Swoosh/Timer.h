@@ -1,6 +1,8 @@
 #pragma once
 
 #include <SFML/System.hpp>
+#include <algorithm>
+#include <deque>
 #include <map>
 #include <vector>
 #include <functional>
@@ -11,16 +13,21 @@ namespace swoosh {
    * @brief Creates stopwatch utility objects that can be paused, reset, and started again
    *
    * Useful for timed beaviors in your applications and is used internally for Segue completion
+   *
+   * Only triggers inside the active window are visited each update. Counting up, triggers start in key order
+   * so a cursor into the trigger map is the start queue. Counting down, tasks come back into progress when
+   * elapsed falls under their end so they are queued by end time instead. Either way an update costs
+   * O(log n + active). The window is rebuilt from scratch when triggers are added or time is moved by hand.
    */
   class Timer {
   public:
     class Trigger; // forward decl
 
   private:
-    sf::Int32 elapsed{ 0 }; //!< Elapsed time in milliseconds
+    sf::Int64 elapsed{ 0 }; //!< Elapsed time in microseconds so short frames do not round away
     bool paused{ true }; //!< If true, paused
     bool reversed{ false }; //!< If true, will count down from `elapsed`
-    std::map<sf::Int32, Trigger> triggers; //!< List of triggers to perform
+    std::map<sf::Int64, Trigger> triggers; //!< List of triggers to perform
   public:
     /**
      * @class Trigger
@@ -34,7 +41,9 @@ namespace swoosh {
       friend class Timer;
 
     private:
-      std::vector<Task> tasks; //!< List of tasks
+      std::deque<Task> tasks; //!< List of tasks. A deque so tasks never move while the timer holds them
+      sf::Int64 start{}; //!< When the tasks begin in microseconds
+      Timer* timer{ nullptr }; //!< Owner to notify when tasks are added
 
     public:
       /**
@@ -48,8 +57,10 @@ namespace swoosh {
         friend class Timer;
 
       private:
-        sf::Int32 duration{}; //!< How long the polling lasts in ms
+        sf::Int64 duration{}; //!< How long the polling lasts in microseconds
         std::function<void(sf::Time)> func; //!< Behavior to execute
+        Trigger* trigger{ nullptr }; //!< Owner of this task
+        std::size_t order{}; //!< Position in the owner's task list
 
       public:
         /**
@@ -69,7 +80,11 @@ namespace swoosh {
         * @param time The duration
         */
         void withDuration(sf::Time time) {
-          duration = time.asMilliseconds();
+          duration = time.asMicroseconds();
+
+          if (trigger && trigger->timer) {
+            trigger->timer->dirty = true;
+          }
         }
       }; // class Task
 
@@ -91,19 +106,70 @@ namespace swoosh {
       */
       Task& doTask(const std::function<void(sf::Time)>& task) {
         tasks.push_back(Task{ task });
-        return tasks.back();
+
+        Task& added = tasks.back();
+        added.trigger = this;
+        added.order = tasks.size() - 1;
+
+        if (timer) {
+          timer->dirty = true;
+        }
+
+        return added;
       }
     }; // class Task
 
+  private:
+    using Task = Trigger::Task;
+
+    std::map<sf::Int64, Trigger>::iterator nextStart; //!< Counting up: first trigger that has not started
+    std::vector<Task*> byEnd; //!< Counting down: finished tasks sorted by latest end first
+    std::size_t nextEnd{}; //!< Counting down: first task in `byEnd` that is not back in progress
+    std::vector<Task*> active; //!< Tasks in progress in the order they were scheduled
+    bool dirty{ true }; //!< If true, the active window is rebuilt on the next update
+
+    static sf::Int64 startOf(const Task* task);
+    static sf::Int64 endOf(const Task* task);
+    static void call(Task* task, sf::Int64 progress);
+    static bool scheduledBefore(const Task* a, const Task* b);
+
+    /**
+      @brief Points every trigger and task back at this timer after the triggers are copied
+    */
+    void rebind();
+
+    void rebuildForward(sf::Int64 from);
+    void rebuildReverse(sf::Int64 from);
+    void updateForward(sf::Int64 from, sf::Int64 to);
+    void updateReverse(sf::Int64 from, sf::Int64 to);
+
+  public:
     /**
     * @brief Constructor. Paused set to true and elapsed set to 0
     */
     Timer() = default;
 
     /**
-    * @brief Copy Constructor. Defaulted.
+    * @brief Copy Constructor. Copies the triggers and their tasks.
     */
-    Timer(const Timer& rhs) = default;
+    Timer(const Timer& rhs) :
+      elapsed(rhs.elapsed), paused(rhs.paused), reversed(rhs.reversed), triggers(rhs.triggers) {
+      rebind();
+    }
+
+    /**
+    * @brief Copy Assignment. Copies the triggers and their tasks.
+    */
+    Timer& operator=(const Timer& rhs) {
+      if (this == &rhs) return *this;
+
+      elapsed = rhs.elapsed;
+      paused = rhs.paused;
+      reversed = rhs.reversed;
+      triggers = rhs.triggers;
+      rebind();
+      return *this;
+    }
 
     /**
     * @brief Deconstructor. Defaulted.
@@ -115,6 +181,7 @@ namespace swoosh {
     */
     void reset() {
       elapsed = 0;
+      dirty = true;
     }
 
     /**
@@ -154,7 +221,7 @@ namespace swoosh {
      @return sf::Time of elapsed time
    */
     sf::Time getElapsed() const {
-      return sf::milliseconds(elapsed);
+      return sf::microseconds(elapsed);
     }
 
 
@@ -170,69 +237,12 @@ namespace swoosh {
         auto lastTickElapsed = elapsed;
 
         if (reversed) {
-          elapsed = std::max<sf::Int32>(0, elapsed - span.asMilliseconds());
-        }
-        else {
-          elapsed += span.asMilliseconds();
-        }
-
-        if (!reversed) {
-          for (auto&& item : triggers) {
-            auto startTime = item.first;
-            if (startTime <= elapsed) {
-              auto trigger = item.second;
-              for (auto&& tasks : trigger.tasks) {
-                auto progress = elapsed - startTime;
-
-                // account for overlapping the final tick for "perfect" animation transitions
-                auto missedProgress = lastTickElapsed - startTime;
-
-                // Check if to update the function or provide the final tick into the function
-                if (progress <= tasks.duration) {
-                  tasks.func ? tasks.func(sf::milliseconds(progress)) : (void)0;
-                }
-                else if (progress > tasks.duration && missedProgress <= tasks.duration) {
-                  // use final tick for "perfect" animation transitions and endings
-                  tasks.func ? tasks.func(sf::milliseconds(tasks.duration)) : (void)0;
-                }
-              }
-            }
-          }
+          elapsed = std::max<sf::Int64>(0, elapsed - span.asMicroseconds());
+          updateReverse(lastTickElapsed, elapsed);
         }
         else {
-          for (auto&& item : triggers) {
-            auto startTime = item.first;
-            // If the start time is behind the elapsed time in reverse,
-            // There's a chance we have a task that needs to be in progress
-            // NOTE: unoptimized. We should change the trigger point to be
-            //                    = startTime + duration
-            if (startTime < elapsed) {
-              auto trigger = item.second;
-              for (auto&& tasks : trigger.tasks) {
-                auto progress = elapsed - startTime;
-
-                // account for overlapping the final tick for "perfect" animation transitions
-                auto missedProgress = lastTickElapsed - (startTime + tasks.duration);
-
-                // Check if to update the function or provide the final tick into the function
-                if (progress <= tasks.duration && progress > 0) {
-                  tasks.func ? tasks.func(sf::milliseconds(progress)) : (void)0;
-                }
-
-              }
-            }
-            else if (elapsed <= startTime) { // this case catches passed items
-              auto trigger = item.second;
-              for (auto&& tasks : trigger.tasks) {
-                auto missedProgress = lastTickElapsed - startTime;
-
-                if (missedProgress > 0) {
-                  // use final tick for "perfect" animation transitions and endings
-                  tasks.func ? tasks.func(sf::milliseconds(0)) : (void)0;
-                }
-              }
-            }
-          }
+          elapsed += span.asMicroseconds();
+          updateForward(lastTickElapsed, elapsed);
         }
       }
     }
@@ -243,7 +253,14 @@ namespace swoosh {
       @return a new Trigger object to perform a task or tasks
     */
     Trigger& at(const sf::Time& time) {
-      const auto& [tuple, status] = triggers.insert({ time.asMilliseconds(), Trigger{} });
+      const auto& [tuple, status] = triggers.insert({ time.asMicroseconds(), Trigger{} });
+
+      if (status) {
+        tuple->second.start = tuple->first;
+        tuple->second.timer = this;
+        dirty = true;
+      }
+
       return tuple->second;
     }
 
@@ -252,12 +269,16 @@ namespace swoosh {
     */
     void clear() {
       triggers.clear();
+      active.clear();
+      byEnd.clear();
+      dirty = true;
     }
 
     /**
       @brief sets the timer to reverse counting from `elapsed`
     */
     void reverse(bool state) {
+      dirty = dirty || this->reversed != state;
       this->reversed = state;
     }
 
@@ -269,7 +290,158 @@ namespace swoosh {
       some given time
       */
     void set(const sf::Time& time) {
-      this->elapsed = time.asMilliseconds();
+      this->elapsed = time.asMicroseconds();
+      dirty = true;
     }
   };
+
+  inline sf::Int64 Timer::startOf(const Task* task) {
+    return task->trigger->start;
+  }
+
+  inline sf::Int64 Timer::endOf(const Task* task) {
+    return task->trigger->start + task->duration;
+  }
+
+  inline void Timer::call(Task* task, sf::Int64 progress) {
+    task->func ? task->func(sf::microseconds(progress)) : (void)0;
+  }
+
+  inline bool Timer::scheduledBefore(const Task* a, const Task* b) {
+    if (startOf(a) != startOf(b)) return startOf(a) < startOf(b);
+
+    return a->order < b->order;
+  }
+
+  inline void Timer::rebind() {
+    for (auto&& [start, trigger] : triggers) {
+      trigger.timer = this;
+
+      for (auto&& task : trigger.tasks) {
+        task.trigger = &trigger;
+      }
+    }
+
+    active.clear();
+    byEnd.clear();
+    dirty = true;
+  }
+
+  /*
+  Counting up, a task is in the window once elapsed reaches its start and stays
+  until the tick after it passes its end, which is the tick that gets the final call.
+  */
+  inline void Timer::rebuildForward(sf::Int64 from) {
+    active.clear();
+    byEnd.clear();
+    nextStart = triggers.upper_bound(from);
+
+    for (auto iter = triggers.begin(); iter != nextStart; iter++) {
+      for (auto&& task : iter->second.tasks) {
+        if (endOf(&task) >= from) {
+          active.push_back(&task);
+        }
+      }
+    }
+
+    dirty = false;
+  }
+
+  inline void Timer::updateForward(sf::Int64 from, sf::Int64 to) {
+    if (dirty) {
+      rebuildForward(from);
+    }
+
+    // triggers are keyed by start time so they enter in schedule order
+    for (; nextStart != triggers.end() && nextStart->first <= to; nextStart++) {
+      for (auto&& task : nextStart->second.tasks) {
+        active.push_back(&task);
+      }
+    }
+
+    std::size_t kept = 0;
+
+    for (std::size_t i = 0; i < active.size(); i++) {
+      Task* task = active[i];
+      auto progress = to - startOf(task);
+
+      // Check if to update the function or provide the final tick into the function
+      if (progress <= task->duration) {
+        call(task, progress);
+      }
+      else {
+        // use final tick for "perfect" animation transitions and endings
+        call(task, task->duration);
+      }
+
+      // tasks that end on this tick get their final tick again on the next one
+      if (endOf(task) >= to) {
+        active[kept++] = task;
+      }
+    }
+
+    active.resize(kept);
+  }
+
+  /*
+  Counting down, a task is in progress while its start < elapsed <= its end.
+  Tasks come back into progress by end time and leave by start time.
+  */
+  inline void Timer::rebuildReverse(sf::Int64 from) {
+    active.clear();
+    byEnd.clear();
+
+    for (auto&& [start, trigger] : triggers) {
+      for (auto&& task : trigger.tasks) {
+        if (endOf(&task) < from) {
+          byEnd.push_back(&task);
+        }
+        else if (start < from) {
+          active.push_back(&task);
+        }
+      }
+    }
+
+    std::stable_sort(byEnd.begin(), byEnd.end(), [](const Task* a, const Task* b) {
+      return endOf(a) > endOf(b);
+    });
+
+    nextEnd = 0;
+    dirty = false;
+  }
+
+  inline void Timer::updateReverse(sf::Int64 from, sf::Int64 to) {
+    if (dirty) {
+      rebuildReverse(from);
+    }
+
+    bool entered = false;
+
+    for (; nextEnd < byEnd.size() && endOf(byEnd[nextEnd]) >= to; nextEnd++) {
+      // tasks that start and end between ticks were passed over entirely
+      if (startOf(byEnd[nextEnd]) < to) {
+        active.push_back(byEnd[nextEnd]);
+        entered = true;
+      }
+    }
+
+    active.erase(std::remove_if(active.begin(), active.end(), [to](const Task* task) {
+      return startOf(task) >= to;
+    }), active.end());
+
+    if (entered) {
+      std::sort(active.begin(), active.end(), scheduledBefore);
+    }
+
+    for (std::size_t i = 0; i < active.size(); i++) {
+      call(active[i], to - startOf(active[i]));
+    }
+
+    // every trigger passed on the way down gets its final tick
+    for (auto iter = triggers.lower_bound(to); iter != triggers.end() && iter->first < from; iter++) {
+      for (auto&& task : iter->second.tasks) {
+        call(&task, 0);
+      }
+    }
+  }
 }
\ No newline at end of file
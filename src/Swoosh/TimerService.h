@@ -0,0 +1,493 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+namespace swoosh {
+  class Activity; /* forward decl */
+
+  /**
+    @class TimerService
+    @brief Runs one-shot and repeating tasks for every activity on a shared hierarchical timing wheel
+
+    Use this instead of a Timer per activity when there are many timers e.g. cooldowns, spawns, and buffs.
+    Scheduling and cancelling are O(1) and the whole service advances in one pass per step.
+
+    Tasks belong to an activity or to no one (nullptr). Tasks owned by an activity only count down while
+    that activity is on top of the stack. They pause during segues and while another activity covers theirs.
+    The ActivityController cancels an activity's tasks when it deletes the activity.
+
+    Time is kept in ticks of 1 millisecond. Delays are rounded up to the next tick so tasks never fire early.
+
+    This is owned by the ActivityController. See: ActivityController::getTimers()
+  */
+  class TimerService {
+  public:
+    using Task = std::function<void()>;
+
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+    /**
+      @class Handle
+      @brief Refers to a scheduled task. Handles to tasks that have finished or were cancelled are safely ignored.
+    */
+    class Handle {
+      friend class TimerService;
+
+      std::uint32_t index{ npos };
+      std::uint32_t generation{};
+
+      Handle(std::uint32_t index, std::uint32_t generation) : index(index), generation(generation) { }
+
+    public:
+      Handle() = default;
+    };
+
+  private:
+    static constexpr unsigned levels = 4;
+    static constexpr unsigned bits = 8;
+    static constexpr std::uint32_t slots = 1u << bits;
+    static constexpr std::uint32_t mask = slots - 1u;
+    static constexpr std::uint64_t range = 1ull << (levels * bits); //!< Furthest tick the wheel can hold
+
+    enum class state : std::uint8_t {
+      free = 0,
+      wheel,   // waiting in a slot
+      parked,  // owner is paused. `deadline` holds the ticks left
+      running, // task is executing
+      cancelled // cancelled while executing
+    };
+
+    struct Node {
+      Task task;
+      const Activity* owner{ nullptr };
+      std::uint64_t deadline{}; //!< Tick to fire on, or ticks remaining while parked
+      std::uint64_t period{}; //!< Ticks between repeats. 0 for one-shot tasks.
+      std::uint32_t generation{}; //!< Bumped every time the node is freed so old handles go stale
+      std::uint32_t slot{ npos }; //!< Wheel slot while waiting in the wheel
+      std::uint32_t prev{ npos }, next{ npos }; //!< Links in a wheel slot or the free list
+      std::uint32_t ownerPrev{ npos }, ownerNext{ npos }; //!< Links in the owner's list
+      state status{ state::free };
+    };
+
+    struct Owner {
+      std::uint32_t head{ npos }; //!< First task owned
+      bool paused{};
+    };
+
+    std::deque<Node> nodes; //!< A deque so a running task is never moved by tasks scheduled inside it
+    std::uint32_t freeHead{ npos };
+    std::array<std::uint32_t, levels * slots> wheel; //!< Head of each slot list, lowest level first
+    std::unordered_map<const Activity*, Owner> owners;
+    const Activity* focused{ nullptr }; //!< Activity on top. Tasks of every other owner are parked.
+    std::uint64_t now{}; //!< Current tick
+    std::int64_t carry{}; //!< Microseconds not yet advanced because they make less than a tick
+    std::size_t pending{}; //!< Tasks waiting or parked
+
+    static std::uint64_t toTicks(sf::Time time) {
+      sf::Int64 us = time.asMicroseconds();
+      return us <= 1000 ? 1u : static_cast<std::uint64_t>((us + 999) / 1000);
+    }
+
+    std::uint32_t allocate() {
+      if (freeHead == npos) {
+        nodes.emplace_back();
+        return static_cast<std::uint32_t>(nodes.size() - 1);
+      }
+
+      std::uint32_t index = freeHead;
+      freeHead = nodes[index].next;
+      return index;
+    }
+
+    void recycle(std::uint32_t index) {
+      Node& node = nodes[index];
+      node.task = nullptr;
+      node.owner = nullptr;
+      node.generation++;
+      node.status = state::free;
+      node.prev = npos;
+      node.next = freeHead;
+      freeHead = index;
+      pending--;
+    }
+
+    /**
+      @brief Files the node into the slot that comes due at its deadline
+    */
+    void insert(std::uint32_t index) {
+      Node& node = nodes[index];
+      std::uint64_t delta = node.deadline > now ? node.deadline - now : 0;
+      std::uint64_t deadline = delta < range ? node.deadline : now + range - 1u;
+
+      unsigned level = 0;
+      while (level + 1 < levels && delta >= (1ull << ((level + 1) * bits))) {
+        level++;
+      }
+
+      std::uint32_t slot = level * slots + static_cast<std::uint32_t>((deadline >> (level * bits)) & mask);
+
+      node.slot = slot;
+      node.status = state::wheel;
+      node.prev = npos;
+      node.next = wheel[slot];
+
+      if (node.next != npos) {
+        nodes[node.next].prev = index;
+      }
+
+      wheel[slot] = index;
+    }
+
+    void unlink(std::uint32_t index) {
+      Node& node = nodes[index];
+
+      if (node.prev != npos) {
+        nodes[node.prev].next = node.next;
+      }
+      else {
+        wheel[node.slot] = node.next;
+      }
+
+      if (node.next != npos) {
+        nodes[node.next].prev = node.prev;
+      }
+
+      node.prev = node.next = npos;
+      node.slot = npos;
+    }
+
+    void linkOwner(std::uint32_t index, Owner& owner) {
+      Node& node = nodes[index];
+      node.ownerPrev = npos;
+      node.ownerNext = owner.head;
+
+      if (owner.head != npos) {
+        nodes[owner.head].ownerPrev = index;
+      }
+
+      owner.head = index;
+    }
+
+    void unlinkOwner(std::uint32_t index) {
+      Node& node = nodes[index];
+
+      if (!node.owner) return;
+
+      auto iter = owners.find(node.owner);
+
+      if (node.ownerPrev != npos) {
+        nodes[node.ownerPrev].ownerNext = node.ownerNext;
+      }
+      else {
+        iter->second.head = node.ownerNext;
+      }
+
+      if (node.ownerNext != npos) {
+        nodes[node.ownerNext].ownerPrev = node.ownerPrev;
+      }
+
+      node.ownerPrev = node.ownerNext = npos;
+    }
+
+    Handle schedule(const Activity* owner, std::uint64_t delay, std::uint64_t period, Task&& task) {
+      std::uint32_t index = allocate();
+      Node& node = nodes[index];
+      node.task = std::move(task);
+      node.owner = owner;
+      node.period = period;
+      pending++;
+
+      bool paused = false;
+
+      if (owner) {
+        auto [iter, inserted] = owners.emplace(owner, Owner());
+
+        if (inserted) {
+          iter->second.paused = owner != focused;
+        }
+
+        paused = iter->second.paused;
+        linkOwner(index, iter->second);
+      }
+
+      if (paused) {
+        node.deadline = delay;
+        node.status = state::parked;
+      }
+      else {
+        node.deadline = now + delay;
+        insert(index);
+      }
+
+      return Handle(index, node.generation);
+    }
+
+    /**
+      @brief Moves every task in a higher level slot down now that its range has come up
+    */
+    void cascade(unsigned level) {
+      std::uint32_t slot = level * slots + static_cast<std::uint32_t>((now >> (level * bits)) & mask);
+      std::uint32_t index = wheel[slot];
+      wheel[slot] = npos;
+
+      while (index != npos) {
+        std::uint32_t next = nodes[index].next;
+        insert(index);
+        index = next;
+      }
+    }
+
+    void fire(std::uint32_t index) {
+      Node& node = nodes[index];
+      unlink(index);
+
+      if (node.deadline > now) {
+        // Was further out than the wheel reaches. Keep waiting.
+        insert(index);
+        return;
+      }
+
+      node.status = state::running;
+      node.task();
+
+      if (node.status == state::running && node.period > 0) {
+        node.deadline = now + node.period;
+
+        auto iter = node.owner ? owners.find(node.owner) : owners.end();
+
+        if (iter != owners.end() && iter->second.paused) {
+          node.deadline = node.period;
+          node.status = state::parked;
+        }
+        else {
+          insert(index);
+        }
+
+        return;
+      }
+
+      unlinkOwner(index);
+      recycle(index);
+    }
+
+    void tick() {
+      now++;
+
+      for (unsigned level = 1; level < levels; level++) {
+        if ((now & ((1ull << (level * bits)) - 1u)) != 0) break;
+
+        cascade(level);
+      }
+
+      std::uint32_t slot = static_cast<std::uint32_t>(now & mask);
+
+      // Tasks may cancel or schedule others while running so take one at a time
+      while (wheel[slot] != npos) {
+        fire(wheel[slot]);
+      }
+    }
+
+    /**
+      @brief Parks every task of the owner with the ticks it had left
+    */
+    void pause(Owner& owner) {
+      if (owner.paused) return;
+
+      owner.paused = true;
+
+      for (std::uint32_t index = owner.head; index != npos; index = nodes[index].ownerNext) {
+        Node& node = nodes[index];
+
+        if (node.status != state::wheel) continue;
+
+        unlink(index);
+        node.deadline = node.deadline > now ? node.deadline - now : 0;
+        node.status = state::parked;
+      }
+    }
+
+    void resume(Owner& owner) {
+      if (!owner.paused) return;
+
+      owner.paused = false;
+
+      for (std::uint32_t index = owner.head; index != npos; index = nodes[index].ownerNext) {
+        Node& node = nodes[index];
+
+        if (node.status != state::parked) continue;
+
+        node.deadline = now + node.deadline;
+        insert(index);
+      }
+    }
+
+    Node* find(const Handle& handle) {
+      if (handle.index >= nodes.size()) return nullptr;
+
+      Node& node = nodes[handle.index];
+
+      if (node.generation != handle.generation || node.status == state::free || node.status == state::cancelled) {
+        return nullptr;
+      }
+
+      return &node;
+    }
+
+  public:
+    TimerService() {
+      wheel.fill(npos);
+    }
+
+    TimerService(const TimerService& rhs) = delete;
+    TimerService& operator=(const TimerService& rhs) = delete;
+
+    /**
+      @brief Runs the task once after the delay
+      @param owner. The activity the task belongs to. The task only counts down while its owner is on top. May be nullptr.
+      @param delay. Time to wait. Rounded up to the next millisecond.
+      @param task. Function to run
+      @return a handle to cancel the task with
+    */
+    Handle after(const Activity* owner, sf::Time delay, Task task) {
+      return schedule(owner, toTicks(delay), 0, std::move(task));
+    }
+
+    /**
+      @brief Runs the task every period until cancelled
+      @param owner. The activity the task belongs to. The task only counts down while its owner is on top. May be nullptr.
+      @param period. Time between runs. The first run is one period from now.
+      @param task. Function to run
+      @return a handle to cancel the task with
+    */
+    Handle every(const Activity* owner, sf::Time period, Task task) {
+      std::uint64_t ticks = toTicks(period);
+      return schedule(owner, ticks, ticks, std::move(task));
+    }
+
+    /**
+      @brief Stops the task from running again. Safe to call from inside the task itself.
+      @return false if the task already finished or was cancelled
+    */
+    bool cancel(const Handle& handle) {
+      Node* node = find(handle);
+
+      if (!node) return false;
+
+      if (node->status == state::running) {
+        node->status = state::cancelled; // freed once it returns
+        return true;
+      }
+
+      if (node->status == state::wheel) {
+        unlink(handle.index);
+      }
+
+      unlinkOwner(handle.index);
+      recycle(handle.index);
+      return true;
+    }
+
+    /**
+      @brief Query if the task will still run
+    */
+    bool isPending(const Handle& handle) {
+      Node* node = find(handle);
+      return node && (node->status != state::running || node->period > 0);
+    }
+
+    /**
+      @brief Query the time left before the task runs next e.g. for cooldown bars
+      @return sf::Time::Zero if the task is not pending
+    */
+    sf::Time getRemaining(const Handle& handle) {
+      Node* node = find(handle);
+
+      if (!node || node->status == state::running) return sf::Time::Zero;
+
+      std::uint64_t ticks = node->status == state::parked ? node->deadline : node->deadline - now;
+      return sf::milliseconds(static_cast<sf::Int32>(ticks));
+    }
+
+    /**
+      @brief Cancels every task the owner has
+    */
+    void release(const Activity* owner) {
+      auto iter = owners.find(owner);
+
+      if (iter == owners.end()) return;
+
+      std::uint32_t index = iter->second.head;
+
+      while (index != npos) {
+        Node& node = nodes[index];
+        std::uint32_t next = node.ownerNext;
+        node.ownerPrev = node.ownerNext = npos;
+        node.owner = nullptr;
+
+        if (node.status == state::running) {
+          node.status = state::cancelled;
+        }
+        else {
+          if (node.status == state::wheel) {
+            unlink(index);
+          }
+
+          recycle(index);
+        }
+
+        index = next;
+      }
+
+      owners.erase(iter);
+    }
+
+    /**
+      @brief Resumes tasks of the activity on top and pauses those of the activity that was
+
+      This is used internally by the ActivityController every step
+    */
+    void focus(const Activity* top) {
+      if (top == focused) return;
+
+      auto last = owners.find(focused);
+
+      if (last != owners.end()) {
+        pause(last->second);
+      }
+
+      focused = top;
+
+      auto next = owners.find(focused);
+
+      if (next != owners.end()) {
+        resume(next->second);
+      }
+    }
+
+    /**
+      @brief Advances every task and runs the ones that come due
+      @param elapsed. Time in seconds
+    */
+    void update(double elapsed) {
+      // Rounded to whole microseconds first so repeated frame deltas do not drift
+      carry += std::llround(elapsed * 1000000.0);
+
+      for (; carry >= 1000; carry -= 1000) {
+        tick();
+      }
+    }
+
+    /**
+      @brief Query the number of tasks waiting to run, including paused ones
+    */
+    const std::size_t size() const {
+      return pending;
+    }
+  };
+}
@@ -0,0 +1,194 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace swoosh {
+  /**
+    @class WorkerPool
+    @brief Fixed set of threads that split loops with the calling thread
+
+    parallelFor() blocks until every index has run so work can be handed out and joined inside one frame.
+    The calling thread works through the range too, so a pool with no workers simply runs the loop inline.
+
+    Only one loop runs on a pool at a time. Calls from other threads wait their turn and calls from inside
+    a running loop run inline instead of deadlocking.
+  */
+  class WorkerPool {
+  private:
+    struct Job {
+      void (*invoke)(void*, std::size_t){ nullptr }; //!< Calls the user function for one index
+      void* context{ nullptr };
+      std::size_t count{};
+      std::size_t chunk{ 1 };
+    };
+
+    std::vector<std::thread> workers;
+    std::mutex mutex, submit;
+    std::condition_variable wake, finished;
+    Job job;
+    std::atomic<std::size_t> next{};
+    std::exception_ptr error; //!< First exception thrown by the job. Rethrown on the calling thread.
+    std::size_t running{}; //!< Workers that have not finished the current job
+    std::uint64_t generation{}; //!< Bumped every job so sleeping workers know there is work
+    bool stopping{ false };
+
+    static bool& insideJob() {
+      static thread_local bool flag = false;
+      return flag;
+    }
+
+    void drain() {
+      bool& inside = insideJob();
+      bool wasInside = inside;
+      inside = true;
+
+      while (true) {
+        std::size_t begin = next.fetch_add(job.chunk, std::memory_order_relaxed);
+
+        if (begin >= job.count) break;
+
+        std::size_t end = std::min(begin + job.chunk, job.count);
+
+        try {
+          for (std::size_t i = begin; i < end; i++) {
+            job.invoke(job.context, i);
+          }
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error) error = std::current_exception();
+          next.store(job.count, std::memory_order_relaxed); // stop handing out work
+        }
+      }
+
+      inside = wasInside;
+    }
+
+    void work() {
+      std::uint64_t seen = 0;
+
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          wake.wait(lock, [this, &seen] { return stopping || generation != seen; });
+
+          if (stopping) return;
+
+          seen = generation;
+        }
+
+        drain();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0) {
+          finished.notify_one();
+        }
+      }
+    }
+
+  public:
+    /**
+      @param threads. Number of worker threads. The calling thread also works so the default leaves one core for it.
+    */
+    explicit WorkerPool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()) - 1u) {
+      workers.reserve(threads);
+
+      for (std::size_t i = 0; i < threads; i++) {
+        workers.emplace_back(&WorkerPool::work, this);
+      }
+    }
+
+    WorkerPool(const WorkerPool& rhs) = delete;
+    WorkerPool& operator=(const WorkerPool& rhs) = delete;
+
+    ~WorkerPool() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+      }
+
+      wake.notify_all();
+
+      for (std::thread& worker : workers) {
+        worker.join();
+      }
+    }
+
+    /**
+      @brief Query the number of threads that work on a loop including the calling thread
+    */
+    const std::size_t getConcurrency() const {
+      return workers.size() + 1u;
+    }
+
+    /**
+      @brief Calls `fn(i)` for every i in [0, count) across the pool and returns when all calls have returned
+      @param count. Number of indices
+      @param fn. Called concurrently from several threads. Must not depend on the order of the indices.
+      @param grain. Smallest number of indices a thread takes at a time. Raise it when each call is tiny.
+      @throws the first exception thrown by `fn`. Remaining indices may not run.
+    */
+    template<typename Fn>
+    void parallelFor(std::size_t count, Fn&& fn, std::size_t grain = 1) {
+      if (count == 0) return;
+
+      if (workers.empty() || count <= grain || insideJob()) {
+        for (std::size_t i = 0; i < count; i++) {
+          fn(i);
+        }
+
+        return;
+      }
+
+      using Callable = std::remove_reference_t<Fn>;
+
+      std::lock_guard<std::mutex> turn(submit);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        job.invoke = [](void* context, std::size_t i) { (*static_cast<Callable*>(context))(i); };
+        job.context = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+        job.count = count;
+        job.chunk = std::max(grain, count / (getConcurrency() * 4u));
+        next.store(0, std::memory_order_relaxed);
+        error = nullptr;
+        running = workers.size();
+        generation++;
+      }
+
+      wake.notify_all();
+      drain();
+
+      std::exception_ptr thrown;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return running == 0; });
+        thrown = error;
+        error = nullptr;
+        job = Job();
+      }
+
+      if (thrown) {
+        std::rethrow_exception(thrown);
+      }
+    }
+
+    /**
+      @brief Pool shared by the library. Created with the default thread count on first use.
+    */
+    static WorkerPool& shared() {
+      static WorkerPool instance;
+      return instance;
+    }
+  };
+}